@@ -41,10 +41,18 @@ setup(
             name="tree_sitter._binding",
             sources=[
                 "tree_sitter/core/lib/src/lib.c",
+                "tree_sitter/binding/allocator.c",
+                "tree_sitter/binding/children_view.c",
+                "tree_sitter/binding/clone_index.c",
+                "tree_sitter/binding/diff.c",
                 "tree_sitter/binding/language.c",
+                "tree_sitter/binding/line_index.c",
                 "tree_sitter/binding/lookahead_iterator.c",
                 "tree_sitter/binding/node.c",
+                "tree_sitter/binding/node_table.c",
+                "tree_sitter/binding/node_tracker.c",
                 "tree_sitter/binding/parser.c",
+                "tree_sitter/binding/path_contexts.c",
                 "tree_sitter/binding/point.c",
                 "tree_sitter/binding/query.c",
                 "tree_sitter/binding/query_cursor.c",
@@ -52,6 +60,7 @@ setup(
                 "tree_sitter/binding/range.c",
                 "tree_sitter/binding/tree.c",
                 "tree_sitter/binding/tree_cursor.c",
+                "tree_sitter/binding/tree_index.c",
                 "tree_sitter/binding/module.c",
             ],
             include_dirs=[
@@ -22,6 +22,25 @@ class TestLanguage(TestCase):
     def test_init_invalid(self):
         self.assertRaises(ValueError, Language, 42)
 
+    def test_init_twice(self):
+        lang = Language(self.json)
+        self.assertEqual(lang.node_kind_for_id(1), "{")
+        self.assertEqual(lang.field_name_for_id(1), "key")
+        self.assertEqual(lang.id_for_node_kind("string", True), 20)
+        self.assertEqual(lang.field_id_for_name("value"), 2)
+
+        lang.__init__(self.python)  # type: ignore[misc]
+        self.assertEqual(lang.node_kind_count, 274)
+        self.assertEqual(lang.field_count, 32)
+        for kind_id in range(lang.node_kind_count):
+            if not lang.node_kind_is_visible(kind_id):
+                continue
+            kind = cast(str, lang.node_kind_for_id(kind_id))
+            found_id = lang.id_for_node_kind(kind, lang.node_kind_is_named(kind_id))
+            self.assertEqual(lang.node_kind_for_id(cast(int, found_id)), kind)
+        field_name = cast(str, lang.field_name_for_id(lang.field_count))
+        self.assertEqual(lang.field_id_for_name(field_name), lang.field_count)
+
     def test_properties(self):
         lang = Language(self.python)
         self.assertEqual(lang.abi_version, 15)
@@ -38,6 +57,20 @@ class TestLanguage(TestCase):
         lang = Language(self.json)
         self.assertEqual(lang.id_for_node_kind(":", False), 4)
         self.assertEqual(lang.id_for_node_kind("string", True), 20)
+        self.assertEqual(lang.id_for_node_kind("ERROR", True), 65535)
+        self.assertEqual(lang.id_for_node_kind("ERROR", False), 65535)
+        self.assertIsNone(lang.id_for_node_kind("strin", True))
+        self.assertIsNone(lang.id_for_node_kind("string", False))
+        self.assertIs(lang.node_kind_for_id(65535), lang.node_kind_for_id(65535))
+        self.assertEqual(lang.node_kind_for_id(65535), "ERROR")
+
+        lang = Language(self.rust)
+        for kind_id in range(lang.node_kind_count):
+            if not lang.node_kind_is_visible(kind_id):
+                continue
+            kind = cast(str, lang.node_kind_for_id(kind_id))
+            found_id = lang.id_for_node_kind(kind, lang.node_kind_is_named(kind_id))
+            self.assertEqual(lang.node_kind_for_id(cast(int, found_id)), kind)
 
     def test_node_kind_is_named(self):
         lang = Language(self.json)
@@ -57,6 +90,12 @@ class TestLanguage(TestCase):
         lang = Language(self.json)
         self.assertEqual(lang.field_id_for_name("key"), 1)
         self.assertEqual(lang.field_id_for_name("value"), 2)
+        self.assertIsNone(lang.field_id_for_name("val"))
+
+        lang = Language(self.rust)
+        for field_id in range(1, lang.field_count + 1):
+            field_name = cast(str, lang.field_name_for_id(field_id))
+            self.assertEqual(lang.field_id_for_name(field_name), field_id)
 
     def test_next_state(self):
         lang = Language(self.javascript)
@@ -1,3 +1,4 @@
+from collections.abc import Sequence
 from typing import cast
 from unittest import TestCase
 
@@ -5,7 +6,7 @@ import tree_sitter_python
 import tree_sitter_javascript
 import tree_sitter_json
 
-from tree_sitter import Language, Node, Parser
+from tree_sitter import ChildrenView, Language, Node, Parser, Point, Range
 
 JSON_EXAMPLE = b"""
 
@@ -80,6 +81,17 @@ class TestNode(TestCase):
         attributes = jsx_node.children_by_field_name("attribute")
         self.assertListEqual([a.type for a in attributes], ["jsx_attribute", "jsx_attribute"])
 
+    def test_fields(self):
+        parser = Parser(self.javascript)
+        tree = parser.parse(b"<div a={1} b={2} />")
+        jsx_node = tree.root_node.children[0].children[0]
+        fields = jsx_node.fields()
+        self.assertListEqual(list(fields), ["name", "attribute"])
+        self.assertListEqual(fields["name"], jsx_node.children_by_field_name("name"))
+        self.assertListEqual(fields["attribute"], jsx_node.children_by_field_name("attribute"))
+        self.assertIs(next(iter(fields)), jsx_node.field_name_for_child(1))
+        self.assertDictEqual(fields["attribute"][0].children[0].fields(), {})
+
     def test_field_name_for_child(self):
         parser = Parser(self.javascript)
         tree = parser.parse(b"<div a={1} b={2} />")
@@ -88,6 +100,20 @@ class TestNode(TestCase):
         self.assertIsNone(jsx_node.field_name_for_child(0))
         self.assertEqual(jsx_node.field_name_for_child(1), "name")
 
+    def test_interned_names(self):
+        parser = Parser(self.python)
+        tree = parser.parse(b"foo(bar)\nbaz(qux)")
+        first_call = tree.root_node.children[0].children[0]
+        second_call = tree.root_node.children[1].children[0]
+        self.assertIs(first_call.type, second_call.type)
+        self.assertIs(first_call.grammar_name, second_call.grammar_name)
+        self.assertIs(first_call.field_name_for_child(0), second_call.field_name_for_child(0))
+        self.assertIs(first_call.type, self.python.node_kind_for_id(first_call.kind_id))
+
+        cursor = first_call.walk()
+        cursor.goto_first_child()
+        self.assertIs(cursor.field_name, self.python.field_name_for_id(cast(int, cursor.field_id)))
+
     def test_root_node_with_offset(self):
         parser = Parser(self.javascript)
         tree = parser.parse(b"  if (a) b")
@@ -133,6 +159,27 @@ class TestNode(TestCase):
             cursor.goto_descendant(i)
             self.assertEqual(cursor.node, node, f"rev index {i}")
 
+    def test_arguments(self):
+        parser = Parser(self.json)
+        tree = parser.parse(JSON_EXAMPLE)
+        root_node = tree.root_node
+        colon_index = JSON_EXAMPLE.index(b":")
+
+        colon_node = cast(Node, root_node.descendant_for_point_range([6, 7], Point(6, 8)))
+        self.assertEqual(colon_node.start_byte, colon_index)
+        self.assertEqual(root_node.child_by_field_name(b"value"), None)
+        with self.assertRaises(TypeError):
+            root_node.descendant_for_byte_range(colon_index)
+        with self.assertRaises(TypeError):
+            root_node.child("0")
+        with self.assertRaises(TypeError):
+            root_node.child_with_descendant(tree)
+
+        self.assertEqual(Point(row=1, column=2), (1, 2))
+        self.assertEqual(Range((0, 0), (0, 1), 0, 1), Range(Point(0, 0), (0, 1), 0, end_byte=1))
+        with self.assertRaises(ValueError):
+            Range((0, 1), (0, 0), 0, 1)
+
     def test_descendant_for_byte_range(self):
         parser = Parser(self.json)
         tree = parser.parse(JSON_EXAMPLE)
@@ -255,8 +302,10 @@ class TestNode(TestCase):
         self.assertEqual(root_node.start_point, (0, 0))
         self.assertEqual(root_node.end_point, (1, 7))
 
-        # List object is reused
+        # The children view is reused, and so are its nodes
         self.assertIs(root_node.children, root_node.children)
+        self.assertIs(root_node.children[0], root_node.children[-1])
+        self.assertIs(root_node.named_children[0], root_node.children[0])
 
         fn_node = root_node.children[0]
         self.assertEqual(fn_node, root_node.child(0))
@@ -292,6 +341,80 @@ class TestNode(TestCase):
         self.assertEqual(statement_node.type, "block")
         self.assertEqual(statement_node.is_named, True)
 
+    def test_children_view(self):
+        parser = Parser(self.json)
+        tree = parser.parse(b"[1, 2, 3]")
+        array_node = tree.root_node.children[0]
+        children = array_node.children
+        self.assertEqual(len(children), 7)
+        self.assertEqual(len(array_node.named_children), 3)
+        self.assertEqual([child.type for child in children[::2]], ["[", ",", ",", "]"])
+        self.assertEqual(children[1:6:2], array_node.named_children)
+        self.assertEqual(list(reversed(children)), list(children)[::-1])
+        self.assertIn(array_node.named_children[1], children)
+        self.assertEqual(array_node.named_children[-1].text, b"3")
+        with self.assertRaises(IndexError):
+            children[7]
+        with self.assertRaises(TypeError):
+            hash(children)
+        self.assertEqual(repr(array_node.children[:1]), repr([children[0]]))
+
+        self.assertIsInstance(children, Sequence)
+        self.assertIsInstance(children, ChildrenView)
+        self.assertEqual(children.index(children[2]), 2)
+        self.assertEqual(children.index(children[2], -5), 2)
+        with self.assertRaises(ValueError):
+            children.index(children[2], 3)
+        with self.assertRaises(ValueError):
+            array_node.named_children.index(children[0])
+        self.assertEqual(children.count(children[1]), 1)
+        self.assertEqual(children.count(array_node), 0)
+        self.assertEqual(children + [array_node], list(children) + [array_node])
+        self.assertEqual(
+            children + array_node.named_children, [*children, *array_node.named_children]
+        )
+        self.assertEqual(
+            array_node.named_children + array_node.named_children,
+            list(array_node.named_children) * 2,
+        )
+        with self.assertRaises(TypeError):
+            children + (array_node,)  # type: ignore[operator]
+
+    def test_ancestors(self):
+        parser = Parser(self.python)
+        tree = parser.parse(b"class A:\n  def f(self):\n    return x\n")
+        node = cast(Node, tree.root_node.descendant_for_byte_range(35, 36))
+        self.assertEqual(node.text, b"x")
+        self.assertEqual(
+            [ancestor.type for ancestor in node.ancestors()],
+            [
+                "return_statement",
+                "block",
+                "function_definition",
+                "block",
+                "class_definition",
+                "module",
+            ],
+        )
+        self.assertEqual(node.ancestors()[0], node.parent)
+        self.assertEqual(tree.root_node.ancestors(), [])
+
+        kinds = ["function_definition", "class_definition"]
+        self.assertEqual([ancestor.type for ancestor in node.ancestors(kinds)], kinds)
+        self.assertEqual(len(node.ancestors(until=["function_definition"])), 3)
+        self.assertEqual(node.ancestors(["class_definition"], ["function_definition"]), [])
+
+        function_id = self.python.id_for_node_kind("function_definition", True)
+        packed = node.ancestors([function_id], packed=True)
+        self.assertEqual(packed.tolist(), [function_id, 11, 36])
+        with self.assertRaises(ValueError):
+            node.ancestors(["not_a_kind"])
+
+        ancestors = node.ancestors()
+        tree.build_parent_index()
+        self.assertEqual(node.ancestors(), ancestors)
+        self.assertEqual(len(node.ancestors(until=["block"], packed=True)), 6)
+
     def test_is_extra(self):
         parser = Parser(self.javascript)
         tree = parser.parse(b"foo(/* hi */);")
@@ -465,6 +588,40 @@ class TestNode(TestCase):
         close_delim_node = list_node.children[4]
         self.assertEqual(close_delim_node.text, b"]")
 
+    def test_text_view(self):
+        parser = Parser(self.python)
+        source = bytearray(b"[0, [1, 2, 3]]")
+        tree = parser.parse(source)
+        child_list_node = tree.root_node.children[0].children[0].children[3]
+        view = cast(memoryview, child_list_node.text_view)
+        self.assertEqual(view, b"[1, 2, 3]")
+        source[5:6] = b"7"
+        source.extend(b"\n")
+        self.assertEqual(view, b"[1, 2, 3]")
+        self.assertEqual(tree.root_node.text, b"[0, [1, 2, 3]]")
+        del view
+
+        tree.edit(0, 1, 1, (0, 0), (0, 1), (0, 1))
+        self.assertIsNone(tree.root_node.text_view)
+
+    def test_text_str(self):
+        parser = Parser(self.python)
+        source = "a = 'ñ'  # 日本\nb = \"\U0001f600\"\n"
+        tree = parser.parse(source.encode())
+        for node in (tree.root_node.children[2], tree.root_node.children[0].children[0]):
+            start, end = cast(int, node.start_char), cast(int, node.end_char)
+            self.assertEqual(source[start:end], node.text_str)
+            self.assertEqual(node.text_str, cast(bytes, node.text).decode())
+        comment = tree.root_node.children[0].next_named_sibling
+        self.assertEqual(cast(Node, comment).text_str, "# 日本")
+
+        long_source = ("é" * 1000 + "\nx\n").encode()
+        tree = parser.parse(long_source)
+        self.assertEqual(tree.root_node.children[-1].start_char, 1001)
+        tree.edit(0, 1, 1, (0, 0), (0, 1), (0, 1))
+        self.assertIsNone(tree.root_node.start_char)
+        self.assertIsNone(tree.root_node.text_str)
+
     def test_text_with_callback_source(self):
         parser = Parser(self.python)
         source_code = b"def foo():\n    return 1\n"
@@ -482,6 +639,55 @@ class TestNode(TestCase):
             with self.subTest(type=factory.__name__):
                 tree = parser.parse(lambda *args, factory=factory: callback_slice(factory, *args))
                 self.assertEqual(tree.root_node.text, source_code)
+                self.assertEqual(tree.root_node.text_view, source_code)
+
+        calls = []
+
+        def read_callback(byte_offset, point):
+            calls.append(byte_offset)
+            return callback_slice(bytes, byte_offset, point)
+
+        tree = parser.parse(read_callback)
+        calls.clear()
+        function_node = tree.root_node.children[0]
+        self.assertEqual(function_node.text, source_code.rstrip())
+        self.assertEqual(cast(Node, function_node.child_by_field_name("name")).text, b"foo")
+        self.assertEqual(cast(Node, function_node.child_by_field_name("body")).text, b"return 1")
+        self.assertEqual(calls, [0, 11])
+
+    def test_reuse(self):
+        parser = Parser(self.python)
+        tree = parser.parse(b"def foo():\n  bar()")
+        for _ in range(1000):
+            function_node = tree.root_node.children[0]
+            self.assertEqual(function_node.type, "function_definition")
+            self.assertEqual(len(function_node.children), 5)
+            del function_node
+            name_node = cast(Node, tree.root_node.children[0].child_by_field_name("name"))
+            self.assertEqual(name_node.children, [])
+            self.assertEqual(name_node.text, b"foo")
+
+        # Hold more nodes than the freelist keeps, so that the next freed node is reused first.
+        root_node = tree.root_node
+        held = [root_node.child(0) for _ in range(300)]
+        function_node = root_node.child(0)
+        address = id(function_node)
+        del function_node
+        function_node = cast(Node, root_node.child(0))
+        self.assertEqual(id(function_node), address)
+        self.assertEqual(function_node.type, "function_definition")
+
+        tree.intern_nodes = True
+        name_node = function_node.child(1)
+        self.assertIs(function_node.child(1), name_node)
+        address = id(name_node)
+        del name_node
+        def_node = cast(Node, function_node.child(0))
+        self.assertEqual(id(def_node), address)
+        self.assertIs(function_node.child(0), def_node)
+        self.assertEqual(cast(Node, function_node.child(1)).type, "identifier")
+        self.assertEqual(def_node.type, "def")
+        del held
 
     def test_hash(self):
         parser = Parser(self.python)
@@ -1,7 +1,7 @@
 from typing import cast
 from unittest import TestCase
 
-from tree_sitter import Language, LogType, Node, Parser, Range, Tree
+from tree_sitter import Language, LogType, MemoryLimitExceeded, Node, Parser, Range, Tree
 
 import tree_sitter_html
 import tree_sitter_javascript
@@ -165,6 +165,52 @@ class TestParser(TestCase):
         self.assertEqual(snake.decode("utf16"), "🐍")
         self.assertIs(tree.language, self.javascript)
 
+    def test_parse_arena(self):
+        parser = Parser(self.python)
+        source = b"def foo():\n  bar()\n"
+        expected = str(parser.parse(source).root_node)
+
+        tree = parser.parse(source, arena=True)
+        self.assertEqual(str(tree.root_node), expected)
+        with self.subTest(old_tree="arena"):
+            tree.edit(19, 19, 25, (2, 0), (2, 0), (2, 6))
+            new_tree = parser.parse(source + b"baz()\n", tree, arena=True)
+            del tree
+            self.assertEqual(new_tree.root_node.child_count, 2)
+        with self.subTest(copy=True):
+            copied = new_tree.copy()
+            del new_tree
+            self.assertEqual(copied.root_node.child_count, 2)
+        with self.subTest(reuse=True):
+            self.assertEqual(str(parser.parse(source).root_node), expected)
+        with self.subTest(cancelled=True):
+            long_source = source * 1000
+            old_tree = parser.parse(long_source, arena=True)
+            with self.assertRaises(ValueError):
+                parser.parse(
+                    lambda byte, _: long_source[byte:], old_tree, progress_callback=lambda *_: True
+                )
+            del old_tree
+            self.assertEqual(str(parser.parse(source).root_node), expected)
+
+    def test_parse_max_memory(self):
+        parser = Parser(self.python)
+        source = b"x = [" + b"1, " * 10000 + b"]\n"
+
+        tree = parser.parse(source)
+        self.assertGreater(parser.peak_memory, 0)
+        peak_memory = parser.peak_memory
+        with self.assertRaises(MemoryLimitExceeded):
+            parser.parse(source, max_memory=peak_memory // 4)
+        with self.assertRaises(MemoryLimitExceeded):
+            parser.parse(lambda byte, _: source[byte:], max_memory=peak_memory // 4)
+        self.assertGreater(parser.peak_memory, peak_memory // 4)
+
+        self.assertEqual(str(parser.parse(source).root_node), str(tree.root_node))
+        self.assertIsNotNone(parser.parse(source, max_memory=peak_memory * 4))
+        with self.assertRaises(ValueError):
+            parser.parse(source, max_memory=0)
+
     def test_parse_invalid_encoding(self):
         parser = Parser(self.python)
         with self.assertRaises(ValueError):
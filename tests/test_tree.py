@@ -1,7 +1,8 @@
+from array import array
 from typing import cast
 from unittest import TestCase
 
-from tree_sitter import Language, Node, Parser
+from tree_sitter import CloneIndex, DiffOperation, Language, Node, NodeTracker, Parser, diff
 
 import tree_sitter_python
 import tree_sitter_rust
@@ -151,3 +152,395 @@ class TestTree(TestCase):
 
         self.assertEqual(copy.goto_parent(), True)
         self.assertEqual(cast(Node, copy.node).type, "struct_item")
+
+    def test_compute_hashes(self):
+        parser = Parser(self.python)
+        tree = parser.parse(b"foo(1)\nbar(1)\nfoo(1)\n")
+        root_node = tree.root_node
+        self.assertIsNone(root_node.structural_hash)
+
+        tree.compute_hashes()
+        first, second, third = root_node.children
+        self.assertEqual(first.structural_hash, third.structural_hash)
+        self.assertNotEqual(first.structural_hash, second.structural_hash)
+
+        other_tree = parser.parse(b"foo(1)\n")
+        other_tree.compute_hashes()
+        self.assertEqual(other_tree.root_node.children[0].structural_hash, first.structural_hash)
+
+        source = b"foo(1)\n"
+        callback_tree = parser.parse(lambda byte, _: source[byte:])
+        callback_tree.compute_hashes()
+        self.assertEqual(
+            callback_tree.root_node.children[0].structural_hash, first.structural_hash
+        )
+
+        tree.compute_hashes(include_text=False)
+        self.assertEqual(first.structural_hash, second.structural_hash)
+
+        tree.edit(0, 0, 1, (0, 0), (0, 0), (0, 1))
+        self.assertIsNone(root_node.structural_hash)
+        with self.assertRaises(ValueError):
+            tree.compute_hashes()
+
+    def test_build_parent_index(self):
+        parser = Parser(self.python)
+        tree = parser.parse(b"def foo():\n  bar(1, 2)\n  baz()\n")
+        nodes, stack = [], [tree.root_node]
+        while stack:
+            node = stack.pop()
+            nodes.append(node)
+            stack.extend(node.children)
+        expected = [(n.parent, n.next_sibling, n.prev_sibling) for n in nodes]
+
+        def positions(node):
+            relatives = (node.parent, node.next_sibling, node.prev_sibling)
+            return [None if n is None else n.start_point for n in relatives]
+
+        offset_node = tree.root_node_with_offset(6, (2, 2)).children[0].children[3]
+        edited_node = tree.root_node.children[0].children[4].children[0]
+        edited_node.edit(0, 0, 2, (0, 0), (0, 0), (0, 2))
+        offset_expected, edited_expected = positions(offset_node), positions(edited_node)
+
+        tree.build_parent_index()
+        self.assertEqual([(n.parent, n.next_sibling, n.prev_sibling) for n in nodes], expected)
+        self.assertIsNone(tree.root_node.parent)
+        self.assertEqual(positions(offset_node), offset_expected)
+        self.assertEqual(positions(edited_node), edited_expected)
+
+        tree.edit(0, 0, 1, (0, 0), (0, 0), (0, 1))
+        self.assertEqual(nodes[1].parent, tree.root_node)
+
+    def test_diff(self):
+        parser = Parser(self.python)
+        old_tree = parser.parse(b"def foo():\n  bar()\n")
+        new_tree = parser.parse(b"def foo():\n  baz()\n")
+        self.assertEqual(len(diff(old_tree, old_tree)), 0)
+
+        script = diff(old_tree, new_tree)
+        operations = [tuple(script[i : i + 3]) for i in range(0, len(script), 3)]
+        self.assertEqual(len(operations), 1)
+        operation, old_index, new_index = operations[0]
+        self.assertEqual(operation, DiffOperation.UPDATE)
+
+        cursor = new_tree.walk()
+        cursor.goto_descendant(new_index)
+        self.assertEqual(cast(Node, cursor.node).text, b"baz")
+        cursor = old_tree.walk()
+        cursor.goto_descendant(old_index)
+        self.assertEqual(cast(Node, cursor.node).text, b"bar")
+
+        new_tree = parser.parse(b"def foo():\n  bar()\n  qux()\n")
+        script = diff(old_tree, new_tree)
+        operations = {script[i] for i in range(0, len(script), 3)}
+        self.assertEqual(operations, {DiffOperation.INSERT})
+
+        source = b"".join(b"def f%d():\n  bar()\n" % i for i in range(20))
+        old_tree = parser.parse(source)
+        start = source.index(b"def f10():\n") + len(b"def f10():\n  ")
+        old_tree.edit(start, start + 3, start + 3, (21, 2), (21, 5), (21, 5))
+        new_tree = parser.parse(source[:start] + b"baz" + source[start + 3 :], old_tree)
+        script = diff(old_tree, new_tree)
+        self.assertEqual(len(script), 3)
+        self.assertEqual(script[0], DiffOperation.UPDATE)
+        cursor = new_tree.walk()
+        cursor.goto_descendant(script[2])
+        self.assertEqual(cast(Node, cursor.node).text, b"baz")
+
+        old_tree = parser.parse(b"def foo():\n  bar()\n")
+        old_tree.compute_hashes()
+        name_hash = old_tree.root_node.children[0].children[1].structural_hash
+        edited_tree = parser.parse(b"def foo():\n  bar()\n")
+        edited_tree.edit(0, 0, 0, (0, 0), (0, 0), (0, 0))
+        diff(old_tree, edited_tree)
+        self.assertEqual(old_tree.root_node.children[0].children[1].structural_hash, name_hash)
+
+        source = b"def foo():\n  baz()\n"
+        new_tree = parser.parse(lambda byte, _: source[byte:])
+        script = diff(old_tree, new_tree)
+        self.assertEqual(list(script[:1]), [DiffOperation.UPDATE])
+        self.assertEqual(len(script), 3)
+
+    def test_intern_nodes(self):
+        parser = Parser(self.python)
+        tree = parser.parse(b"def foo():\n  bar()\n")
+        self.assertFalse(tree.intern_nodes)
+        self.assertIsNot(tree.root_node, tree.root_node)
+
+        tree.intern_nodes = True
+        self.assertTrue(tree.intern_nodes)
+        root = tree.root_node
+        self.assertIs(tree.root_node, root)
+        function = root.children[0]
+        self.assertIs(root.child(0), function)
+        self.assertIs(function.parent, root)
+        cursor = tree.walk()
+        cursor.goto_first_child()
+        self.assertIs(cursor.node, function)
+        self.assertIsNot(tree.copy().root_node, root)
+        self.assertTrue(tree.copy().intern_nodes)
+
+        name = cast(Node, function.child_by_field_name("name"))
+        self.assertIs(function.child(1), name)
+        name.edit(0, 0, 4, (0, 0), (0, 0), (0, 4))
+        self.assertEqual(name.start_byte, 8)
+        self.assertIsNot(function.child(1), name)
+        del name
+        name = cast(Node, function.child(1))
+        self.assertEqual((name.type, name.start_byte, name.text), ("identifier", 4, b"foo"))
+        self.assertIs(function.child(1), name)
+
+        tree.edit(0, 0, 1, (0, 0), (0, 1), (0, 0))
+        edited = tree.root_node
+        self.assertIsNot(edited, root)
+        self.assertIs(tree.root_node, edited)
+
+        tree.intern_nodes = False
+        self.assertIsNot(tree.root_node, edited)
+
+    def test_node_tracker(self):
+        parser = Parser(self.python)
+        tree = parser.parse(b"def foo():\n  bar()\n")
+        tracker = NodeTracker(tree)
+        self.assertIs(tracker.tree, tree)
+        self.assertIs(tree.tracker, tracker)
+        self.assertEqual(len(tracker), tree.root_node.descendant_count)
+        with self.assertRaises(ValueError):
+            NodeTracker(tree)
+
+        function = tree.root_node.children[0]
+        name_id = tracker[cast(Node, function.child_by_field_name("name"))]
+        call_id = tracker[cast(Node, cast(Node, function.child_by_field_name("body")).children[0])]
+
+        tree.edit(13, 16, 16, (1, 2), (1, 5), (1, 5))
+        new_tree = parser.parse(b"def foo():\n  baz()\n", tree)
+        self.assertIs(tracker.tree, new_tree)
+        self.assertIsNone(tree.tracker)
+        self.assertIs(new_tree.tracker, tracker)
+
+        function = new_tree.root_node.children[0]
+        self.assertEqual(tracker[cast(Node, function.child_by_field_name("name"))], name_id)
+        body = cast(Node, function.child_by_field_name("body"))
+        self.assertEqual(tracker[body.children[0]], call_id)
+        with self.assertRaises(KeyError):
+            tracker[tree.root_node]
+
+        tree = parser.parse(b"def foo():\n  bar()\nx = 1\n")
+        tracker = NodeTracker(tree)
+        statement_id = tracker[tree.root_node.children[1]]
+        tree.edit(13, 16, 17, (1, 2), (1, 5), (1, 6))
+        self.assertEqual(len(tracker), tree.root_node.descendant_count)
+        new_tree = parser.parse(b"def foo():\n  bazz()\nx = 1\n", tree)
+        self.assertEqual(len(tracker), new_tree.root_node.descendant_count)
+        self.assertEqual(tracker[new_tree.root_node.children[1]], statement_id)
+
+    def test_errors(self):
+        parser = Parser(self.python)
+        tree = parser.parse(b"def foo():\n  bar()\n")
+        self.assertEqual(tree.errors(), [])
+
+        tree = parser.parse(b"def foo(:\n  bar()\nx = (1\ny = 2\n")
+        errors = tree.errors()
+        self.assertGreater(len(errors), 0)
+        for error in errors:
+            self.assertTrue(error.is_error or error.is_missing)
+        self.assertEqual([node.start_byte for node in errors],
+                         sorted(node.start_byte for node in errors))
+        self.assertEqual(tree.errors(limit=1), errors[:1])
+        self.assertEqual(tree.errors(limit=0), [])
+        with self.assertRaises(ValueError):
+            tree.errors(limit=-1)
+
+    def test_stats(self):
+        parser = Parser(self.python)
+        tree = parser.parse(b"def foo():\n  bar()\n")
+        stats = tree.stats()
+        root_node = tree.root_node
+        self.assertEqual(len(stats["kinds"]), self.python.node_kind_count + 1)
+        self.assertEqual(sum(stats["kinds"]), root_node.descendant_count)
+        self.assertEqual(stats["kinds"][self.python.id_for_node_kind("identifier", True)], 2)
+        self.assertEqual(stats["depths"][0], 1)
+        self.assertEqual(sum(stats["depths"]), root_node.descendant_count)
+        self.assertEqual(stats["named"] + stats["anonymous"], root_node.descendant_count)
+        self.assertEqual(stats["errors"], 0)
+        self.assertEqual(stats["missing"], 0)
+        self.assertEqual(stats["error_bytes"], 0)
+        self.assertEqual(stats["covered_bytes"], 14)
+
+        tree = parser.parse(b"def foo(:\n  bar()\n")
+        stats = tree.stats()
+        self.assertGreater(stats["errors"], 0)
+        self.assertEqual(stats["kinds"][-1], stats["errors"])
+        self.assertEqual(sum(stats["kinds"]), tree.root_node.descendant_count)
+        self.assertGreater(stats["error_bytes"], 0)
+
+    def test_tokens(self):
+        parser = Parser(self.python)
+        source = b"foo(1)  # bar\n"
+        tree = parser.parse(source)
+        tokens = tree.tokens()
+        self.assertEqual(len(tokens) % 5, 0)
+        records = [tuple(tokens[i : i + 5]) for i in range(0, len(tokens), 5)]
+        self.assertEqual(
+            [source[start:end] for _, start, end, _, _ in records],
+            [b"foo", b"(", b"1", b")", b"# bar"],
+        )
+        identifier = self.python.id_for_node_kind("identifier", True)
+        self.assertEqual(records[0], (identifier, 0, 3, 1, 0))
+        self.assertEqual(records[-1][4], 1)
+        self.assertEqual(len(tree.tokens(False)), len(tokens) - 5)
+
+        tokens, text, offsets = tree.tokens(include_text=True)
+        self.assertEqual(text, b"foo(1)# bar")
+        self.assertEqual(list(offsets), [0, 3, 4, 5, 6, 11])
+
+        tree = parser.parse(lambda byte, _: source[byte:])
+        self.assertEqual(tree.tokens(include_text=True)[1], b"foo(1)# bar")
+        tree.edit(0, 1, 1, (0, 0), (0, 1), (0, 1))
+        with self.assertRaises(ValueError):
+            tree.tokens(include_text=True)
+
+    def test_texts(self):
+        parser = Parser(self.python)
+        source = "x = 'é'\n".encode()
+        tree = parser.parse(source)
+        assignment = cast(Node, tree.root_node.child(0)).child(0)
+        left, _, right = cast(Node, assignment).children
+        items = [left, right.range, (2, 3), (0, 100)]
+        self.assertEqual(tree.texts(items), [b"x", "'é'".encode(), b"=", source])
+        self.assertEqual(tree.texts([right], as_str=True), ["'é'"])
+
+        text, offsets = tree.texts(items, packed=True)
+        self.assertEqual(text, b"x" + "'é'".encode() + b"=" + source)
+        self.assertEqual(list(offsets), [0, 1, 5, 6, len(text)])
+        self.assertEqual(tree.texts([], packed=True), (b"", array("I", [0])))
+
+        with self.assertRaises(ValueError):
+            tree.texts([(3, 2)])
+        with self.assertRaises(TypeError):
+            tree.texts([None])
+        with self.assertRaises(ValueError):
+            tree.texts([parser.parse(b"y = 1\n").root_node])
+        tree.edit(0, 1, 1, (0, 0), (0, 1), (0, 1))
+        with self.assertRaises(ValueError):
+            tree.texts([left])
+
+    def test_utf16_points(self):
+        parser = Parser(self.python)
+        source = "x = 1\ny = '\U0001f600é' + z\n".encode()
+        tree = parser.parse(source)
+        z_byte = source.index(b"z")
+        self.assertEqual(tree.to_utf16_point((0, 4)), (0, 4))
+        self.assertEqual(tree.to_utf16_point(z_byte), (1, 12))
+        self.assertEqual(tree.to_utf16_point((1, z_byte - 6)), (1, 12))
+        self.assertEqual(tree.from_utf16_point((1, 12)), (1, z_byte - 6))
+        self.assertEqual(tree.from_utf16_point((1, 100)), (1, len(source) - 7))
+        self.assertEqual(tree.from_utf16_point((5, 0)), (2, 0))
+
+        points = array("I", [0, 4, 1, z_byte - 6])
+        converted = tree.to_utf16_points(points)
+        self.assertEqual(list(converted), [0, 4, 1, 12])
+        self.assertEqual(tree.from_utf16_points(converted), points)
+        with self.assertRaises(ValueError):
+            tree.to_utf16_points(array("H", [0, 1]))
+        with self.assertRaises(ValueError):
+            tree.to_utf16_points(array("i", [0, 4]))
+        with self.assertRaises(ValueError):
+            tree.to_utf16_points(array("f", [0, 4]))
+
+    def test_path_contexts(self):
+        parser = Parser(self.python)
+        tree = parser.parse(b"x = y\n")
+        identifier = self.python.id_for_node_kind("identifier", True)
+        assignment = self.python.id_for_node_kind("assignment", True)
+
+        contexts, paths = tree.path_contexts(hashed=False, leaf_filter=[identifier])
+        self.assertEqual(len(contexts), 5)
+        start, end, offset, length, up = contexts
+        cursor = tree.walk()
+        cursor.goto_descendant(start)
+        self.assertEqual(cast(Node, cursor.node).text, b"x")
+        cursor.goto_descendant(end)
+        self.assertEqual(cast(Node, cursor.node).text, b"y")
+        self.assertEqual(list(paths[offset : offset + length]), [identifier, assignment, identifier])
+        self.assertEqual(up, 1)
+
+        hashed = tree.path_contexts(leaf_filter=[identifier])
+        self.assertEqual(len(hashed), 3)
+        self.assertEqual((hashed[0], hashed[2]), (start, end))
+        self.assertEqual(len(tree.path_contexts(max_width=1)), 2 * 3)
+        self.assertEqual(len(tree.path_contexts(max_width=2)), 3 * 3)
+        with self.assertRaises(ValueError):
+            tree.path_contexts(max_length=1)
+
+    def test_chunk(self):
+        parser = Parser(self.python)
+        source = b"import a\nimport b\n\ndef foo():\n    x = 1\n    return x\ny = 2\n"
+        tree = parser.parse(source)
+
+        chunks = tree.chunk(len(source))
+        self.assertEqual(list(chunks), [0, len(source)])
+
+        chunks = tree.chunk(20)
+        ranges = [(chunks[i], chunks[i + 1]) for i in range(0, len(chunks), 2)]
+        self.assertEqual(ranges[0], (0, 17))
+        self.assertTrue(all(end - start <= 20 for start, end in ranges))
+        self.assertEqual([start for start, _ in ranges], sorted(start for start, _ in ranges))
+
+        self.assertEqual(list(tree.chunk(40)), [0, 17, 19, 58])
+        chunks = tree.chunk(40, prefer_kinds=["function_definition"])
+        self.assertEqual(list(chunks), [0, 17, 19, 52, 53, 58])
+        chunks = tree.chunk(40, prefer_kinds=["function_definition"], overlap=4)
+        self.assertEqual(list(chunks), [0, 17, 13, 52, 48, 58])
+
+        with self.assertRaises(ValueError):
+            tree.chunk(0)
+        with self.assertRaises(ValueError):
+            tree.chunk(40, prefer_kinds=["not_a_kind"])
+
+        source = 'x = "ééééé"\n'.encode()
+        tree = parser.parse(source)
+        for max_bytes in (1, 3):
+            chunks = tree.chunk(max_bytes, overlap=1)
+            for i in range(0, len(chunks), 2):
+                source[chunks[i] : chunks[i + 1]].decode()
+
+    def test_clone_index(self):
+        parser = Parser(self.python)
+        foo = parser.parse(b"def foo(a, b):\n    c = a + b\n    return c\n")
+        bar = parser.parse(b"def bar(x, y):\n    z = x + y\n    return z\n")
+        baz = parser.parse(b"def baz():\n    pass\n")
+
+        index = CloneIndex(min_size=5)
+        foo_key, bar_key = index.add(foo), index.add(bar)
+        self.assertEqual(len(index), 2)
+        groups = index.groups()
+        self.assertEqual(len(groups), 1)
+        self.assertEqual([key for key, _, _ in groups[0]], [foo_key, bar_key])
+        self.assertEqual(groups[0][0][1:], (0, foo.root_node.end_byte))
+
+        index.update(bar_key, baz)
+        self.assertEqual(index.groups(), [])
+        index.update(bar_key, bar)
+        self.assertEqual(len(index.groups()), 1)
+        index.remove(bar_key)
+        self.assertEqual(len(index), 1)
+        self.assertEqual(index.groups(), [])
+        with self.assertRaises(KeyError):
+            index.remove(bar_key)
+
+        index = CloneIndex(min_size=5, abstract_identifiers=False)
+        index.add(foo)
+        index.add(bar)
+        self.assertEqual(index.groups(), [])
+        index.add(foo)
+        self.assertEqual(len(index.groups()), 1)
+        source = b"def bar(x, y):\n    z = x + y\n    return z\n"
+        index.add(parser.parse(lambda byte, _: source[byte:]))
+        self.assertEqual([len(group) for group in index.groups()], [2, 2])
+        baz.edit(0, 0, 0, (0, 0), (0, 0), (0, 0))
+        with self.assertRaises(ValueError):
+            index.add(baz)
+
+        with self.assertRaises(ValueError):
+            index.add(Parser(self.rust).parse(b"fn main() {}"))
@@ -1,12 +1,18 @@
 """Python bindings to the Tree-sitter parsing library."""
 
+from collections.abc import Sequence as _Sequence
 from typing import Protocol as _Protocol
 
 from ._binding import (
+    ChildrenView,
+    CloneIndex,
+    DiffOperation,
     Language,
     LogType,
     LookaheadIterator,
+    MemoryLimitExceeded,
     Node,
+    NodeTracker,
     Parser,
     Point,
     Query,
@@ -17,10 +23,14 @@ from ._binding import (
     TreeCursor,
     LANGUAGE_VERSION,
     MIN_COMPATIBLE_LANGUAGE_VERSION,
-    __version__
+    __version__,
+    diff,
 )
 
 LogType.__doc__ = "The type of a log message."
+DiffOperation.__doc__ = "The type of an operation in an edit script."
+
+_Sequence.register(ChildrenView)
 
 
 class QueryPredicate(_Protocol):
@@ -50,10 +60,15 @@ class QueryPredicate(_Protocol):
 
 
 __all__ = [
+    "ChildrenView",
+    "CloneIndex",
+    "DiffOperation",
     "Language",
     "LogType",
     "LookaheadIterator",
+    "MemoryLimitExceeded",
     "Node",
+    "NodeTracker",
     "Parser",
     "Point",
     "Query",
@@ -65,5 +80,6 @@ __all__ = [
     "TreeCursor",
     "LANGUAGE_VERSION",
     "MIN_COMPATIBLE_LANGUAGE_VERSION",
-    "__version__"
+    "__version__",
+    "diff",
 ]
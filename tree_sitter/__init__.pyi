@@ -1,8 +1,20 @@
+from array import array
 from enum import IntEnum
-from collections.abc import ByteString, Callable, Iterator, Sequence
-from typing import Annotated, Any, Final, Literal, Protocol, Self, final, overload
+from collections.abc import ByteString, Callable, Iterable, Iterator, Sequence
+from typing import Annotated, Any, Final, Literal, Protocol, Self, TypedDict, final, overload
 from typing_extensions import deprecated
 
+class _TreeStats(TypedDict):
+    kinds: array[int]
+    depths: array[int]
+    named: int
+    anonymous: int
+    extra: int
+    errors: int
+    missing: int
+    covered_bytes: int
+    error_bytes: int
+
 class _SupportsFileno(Protocol):
     def fileno(self) -> int: ...
 
@@ -10,6 +22,12 @@ class LogType(IntEnum):
     PARSE: int
     LEX: int
 
+class DiffOperation(IntEnum):
+    INSERT: int
+    DELETE: int
+    UPDATE: int
+    MOVE: int
+
 @final
 class Language:
     @overload
@@ -89,11 +107,11 @@ class Node:
     @property
     def end_point(self) -> Point: ...
     @property
-    def children(self) -> list[Node]: ...
+    def children(self) -> ChildrenView: ...
     @property
     def child_count(self) -> int: ...
     @property
-    def named_children(self) -> list[Node]: ...
+    def named_children(self) -> ChildrenView: ...
     @property
     def named_child_count(self) -> int: ...
     @property
@@ -110,7 +128,33 @@ class Node:
     def descendant_count(self) -> int: ...
     @property
     def text(self) -> bytes | None: ...
+    @property
+    def text_view(self) -> memoryview | None: ...
+    @property
+    def text_str(self) -> str | None: ...
+    @property
+    def start_char(self) -> int | None: ...
+    @property
+    def end_char(self) -> int | None: ...
+    @property
+    def structural_hash(self) -> int | None: ...
     def walk(self) -> TreeCursor: ...
+    @overload
+    def ancestors(
+        self,
+        kinds: Iterable[int | str] | None = None,
+        until: Iterable[int | str] | None = None,
+        *,
+        packed: Literal[False] = False,
+    ) -> list[Node]: ...
+    @overload
+    def ancestors(
+        self,
+        kinds: Iterable[int | str] | None = None,
+        until: Iterable[int | str] | None = None,
+        *,
+        packed: Literal[True],
+    ) -> array[int]: ...
     def edit(
         self,
         start_byte: int,
@@ -129,6 +173,7 @@ class Node:
     def child_with_descendant(self, descendant: Node, /) -> Node | None: ...
     def children_by_field_id(self, id: int, /) -> list[Node]: ...
     def children_by_field_name(self, name: str, /) -> list[Node]: ...
+    def fields(self) -> dict[str, list[Node]]: ...
     def field_name_for_child(self, child_index: int, /) -> str | None: ...
     def field_name_for_named_child(self, child_index: int, /) -> str | None: ...
     def descendant_for_byte_range(
@@ -161,6 +206,17 @@ class Node:
     def __ne__(self, other: Any, /) -> bool: ...
     def __hash__(self) -> int: ...
 
+@final
+class ChildrenView(Sequence[Node]):
+    @overload
+    def __getitem__(self, index: int, /) -> Node: ...
+    @overload
+    def __getitem__(self, index: slice, /) -> list[Node]: ...
+    def __len__(self) -> int: ...
+    def __add__(self, other: list[Node] | ChildrenView, /) -> list[Node]: ...
+    def index(self, value: Node, start: int = 0, stop: int = ..., /) -> int: ...
+    def count(self, value: Node, /) -> int: ...
+
 @final
 class Tree:
     @property
@@ -169,12 +225,86 @@ class Tree:
     def included_ranges(self) -> list[Range]: ...
     @property
     def language(self) -> Language: ...
+    @property
+    def tracker(self) -> NodeTracker | None: ...
+    @property
+    def intern_nodes(self) -> bool: ...
+    @intern_nodes.setter
+    def intern_nodes(self, intern: bool) -> None: ...
     def root_node_with_offset(
         self,
         offset_bytes: int,
         offset_extent: Point | tuple[int, int],
         /,
     ) -> Node | None: ...
+    def build_parent_index(self) -> None: ...
+    def compute_hashes(self, include_text: bool = True) -> None: ...
+    def errors(self, limit: int | None = None) -> list[Node]: ...
+    def stats(self) -> _TreeStats: ...
+    def chunk(
+        self,
+        max_bytes: int,
+        *,
+        prefer_kinds: Iterable[int | str] | None = None,
+        overlap: int = 0,
+    ) -> array[int]: ...
+    @overload
+    def path_contexts(
+        self,
+        max_length: int = 8,
+        max_width: int = 2,
+        *,
+        leaf_filter: Iterable[int | str] | None = None,
+        hashed: Literal[True] = True,
+    ) -> array[int]: ...
+    @overload
+    def path_contexts(
+        self,
+        max_length: int = 8,
+        max_width: int = 2,
+        *,
+        leaf_filter: Iterable[int | str] | None = None,
+        hashed: Literal[False],
+    ) -> tuple[array[int], array[int]]: ...
+    @overload
+    def tokens(
+        self, include_extras: bool = True, *, include_text: Literal[False] = False
+    ) -> array[int]: ...
+    @overload
+    def tokens(
+        self, include_extras: bool = True, *, include_text: Literal[True]
+    ) -> tuple[array[int], bytes, array[int]]: ...
+    @overload
+    def texts(
+        self,
+        items: Sequence[Node | Range | tuple[int, int]],
+        /,
+        *,
+        as_str: Literal[False] = False,
+        packed: Literal[False] = False,
+    ) -> list[bytes]: ...
+    @overload
+    def texts(
+        self,
+        items: Sequence[Node | Range | tuple[int, int]],
+        /,
+        *,
+        as_str: Literal[True],
+        packed: Literal[False] = False,
+    ) -> list[str]: ...
+    @overload
+    def texts(
+        self,
+        items: Sequence[Node | Range | tuple[int, int]],
+        /,
+        *,
+        as_str: Literal[False] = False,
+        packed: Literal[True],
+    ) -> tuple[bytes, array[int]]: ...
+    def to_utf16_point(self, position: int | Point | tuple[int, int], /) -> Point: ...
+    def from_utf16_point(self, point: Point | tuple[int, int], /) -> Point: ...
+    def to_utf16_points(self, points: array[int], /) -> array[int]: ...
+    def from_utf16_points(self, points: array[int], /) -> array[int]: ...
     def copy(self) -> Tree: ...
     def edit(
         self,
@@ -190,6 +320,27 @@ class Tree:
     def print_dot_graph(self, file: _SupportsFileno, /) -> None: ...
     def __copy__(self) -> Tree: ...
 
+@final
+class CloneIndex:
+    def __init__(self, min_size: int = 10, *, abstract_identifiers: bool = True) -> None: ...
+    @property
+    def min_size(self) -> int: ...
+    @property
+    def abstract_identifiers(self) -> bool: ...
+    def add(self, tree: Tree, /) -> int: ...
+    def update(self, key: int, tree: Tree, /) -> None: ...
+    def remove(self, key: int, /) -> None: ...
+    def groups(self) -> list[list[tuple[int, int, int]]]: ...
+    def __len__(self) -> int: ...
+
+@final
+class NodeTracker:
+    def __init__(self, tree: Tree) -> None: ...
+    @property
+    def tree(self) -> Tree | None: ...
+    def __getitem__(self, node: Node, /) -> int: ...
+    def __len__(self) -> int: ...
+
 @final
 class TreeCursor:
     @property
@@ -242,6 +393,8 @@ class Parser:
     def logger(self, logger: Callable[[LogType, str], None]) -> None: ...
     @logger.deleter
     def logger(self) -> None: ...
+    @property
+    def peak_memory(self) -> int: ...
     @overload
     def parse(
         self,
@@ -249,6 +402,9 @@ class Parser:
         /,
         old_tree: Tree | None = None,
         encoding: Literal["utf8", "utf16", "utf16le", "utf16be"] = "utf8",
+        *,
+        arena: bool = False,
+        max_memory: int | None = None,
     ) -> Tree: ...
     @overload
     def parse(
@@ -258,12 +414,17 @@ class Parser:
         old_tree: Tree | None = None,
         encoding: Literal["utf8", "utf16", "utf16le", "utf16be"] = "utf8",
         progress_callback: Callable[[int, bool], bool] | None = None,
+        *,
+        arena: bool = False,
+        max_memory: int | None = None,
     ) -> Tree: ...
     def reset(self) -> None: ...
     def print_dot_graphs(self, file: _SupportsFileno | None, /) -> None: ...
 
 class QueryError(ValueError): ...
 
+class MemoryLimitExceeded(MemoryError): ...
+
 class QueryPredicate(Protocol):
     def __call__(
         self,
@@ -408,3 +569,5 @@ LANGUAGE_VERSION: Final[int]
 MIN_COMPATIBLE_LANGUAGE_VERSION: Final[int]
 
 __version__: Final[str]
+
+def diff(old_tree: Tree, new_tree: Tree) -> array[int]: ...
@@ -0,0 +1,259 @@
+#include "types.h"
+
+#include <string.h>
+
+#ifdef _MSC_VER
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL _Thread_local
+#endif
+
+// Every block handed to the core library is prefixed with a header that
+// records its size and whether it lives inside an arena. Arena blocks are
+// never freed individually; they are released together with their arena.
+//
+// Heap blocks come from the raw allocator, because the library also allocates
+// while the GIL is released, e.g. for the stack of a tree cursor.
+typedef uint64_t AllocHeader;
+
+#define HEADER_SIZE sizeof(AllocHeader)
+#define HEADER_ARENA ((AllocHeader)1 << 63)
+#define HEADER_SIZE_MASK (HEADER_ARENA - 1)
+
+#define HEADER_OF(ptr) ((AllocHeader *)(ptr) - 1)
+#define ALIGN_UP(size) (((size) + (HEADER_SIZE - 1)) & ~(HEADER_SIZE - 1))
+
+#define ARENA_MIN_CHUNK_SIZE ((size_t)64 * 1024)
+#define ARENA_MAX_CHUNK_SIZE ((size_t)16 * 1024 * 1024)
+
+typedef struct ArenaChunk {
+    struct ArenaChunk *next;
+    size_t size;
+} ArenaChunk;
+
+struct TreeArena {
+    Py_ssize_t ref_count;
+    ArenaChunk *chunks;
+    char *top;
+    char *end;
+    AllocHeader *last;
+    size_t size;
+    bool is_shared;
+    TreeArena *parent;
+};
+
+static THREAD_LOCAL TreeArena *current_arena = NULL;
+
+static THREAD_LOCAL MemoryBudget *current_budget = NULL;
+
+static inline void budget_add(size_t size) {
+    MemoryBudget *budget = current_budget;
+    if (budget != NULL) {
+        budget->used += size;
+        if (budget->used > budget->peak) {
+            budget->peak = budget->used;
+        }
+    }
+}
+
+static inline void budget_remove(size_t size) {
+    MemoryBudget *budget = current_budget;
+    if (budget != NULL) {
+        // blocks allocated before the budget was installed may be freed too
+        budget->used = budget->used > size ? budget->used - size : 0;
+    }
+}
+
+static void *arena_alloc(TreeArena *arena, size_t size) {
+    size_t total = ALIGN_UP(HEADER_SIZE + size);
+    if (arena->top == NULL || (size_t)(arena->end - arena->top) < total) {
+        size_t chunk_size = arena->size < ARENA_MIN_CHUNK_SIZE ? ARENA_MIN_CHUNK_SIZE
+                            : arena->size > ARENA_MAX_CHUNK_SIZE ? ARENA_MAX_CHUNK_SIZE
+                                                                 : arena->size;
+        if (chunk_size < total + sizeof(ArenaChunk)) {
+            chunk_size = total + sizeof(ArenaChunk);
+        }
+        ArenaChunk *chunk = PyMem_Malloc(chunk_size);
+        if (chunk == NULL) {
+            return NULL;
+        }
+        chunk->next = arena->chunks;
+        chunk->size = chunk_size;
+        arena->chunks = chunk;
+        arena->size += chunk_size;
+        arena->top = (char *)(chunk + 1);
+        arena->end = (char *)chunk + chunk_size;
+    }
+
+    AllocHeader *header = (AllocHeader *)arena->top;
+    *header = (AllocHeader)size | HEADER_ARENA;
+    arena->last = header;
+    arena->top += total;
+    return header + 1;
+}
+
+static bool arena_grow_last(TreeArena *arena, AllocHeader *header, size_t size) {
+    if (header != arena->last) {
+        return false;
+    }
+    size_t total = ALIGN_UP(HEADER_SIZE + size);
+    if ((size_t)(arena->end - (char *)header) < total) {
+        return false;
+    }
+    *header = (AllocHeader)size | HEADER_ARENA;
+    arena->top = (char *)header + total;
+    return true;
+}
+
+void *allocator_malloc(size_t size) {
+    budget_add(size);
+    if (current_arena != NULL) {
+        return arena_alloc(current_arena, size);
+    }
+    AllocHeader *header = PyMem_RawMalloc(HEADER_SIZE + size);
+    if (header == NULL) {
+        return NULL;
+    }
+    *header = (AllocHeader)size;
+    return header + 1;
+}
+
+void *allocator_calloc(size_t count, size_t size) {
+    if (size != 0 && count > (SIZE_MAX - HEADER_SIZE) / size) {
+        return NULL;
+    }
+    size_t total = count * size;
+    budget_add(total);
+    if (current_arena != NULL) {
+        void *result = arena_alloc(current_arena, total);
+        if (result != NULL) {
+            memset(result, 0, total);
+        }
+        return result;
+    }
+    AllocHeader *header = PyMem_RawCalloc(1, HEADER_SIZE + total);
+    if (header == NULL) {
+        return NULL;
+    }
+    *header = (AllocHeader)total;
+    return header + 1;
+}
+
+void *allocator_realloc(void *ptr, size_t size) {
+    if (ptr == NULL) {
+        return allocator_malloc(size);
+    }
+
+    AllocHeader *header = HEADER_OF(ptr);
+    size_t old_size = (size_t)(*header & HEADER_SIZE_MASK);
+    if (!(*header & HEADER_ARENA)) {
+        // heap blocks stay on the heap, even while an arena is active
+        budget_remove(old_size);
+        budget_add(size);
+        header = PyMem_RawRealloc(header, HEADER_SIZE + size);
+        if (header == NULL) {
+            return NULL;
+        }
+        *header = (AllocHeader)size;
+        return header + 1;
+    }
+
+    if (current_arena != NULL && arena_grow_last(current_arena, header, size)) {
+        budget_add(size > old_size ? size - old_size : 0);
+        return ptr;
+    }
+    void *result = allocator_malloc(size);
+    if (result != NULL) {
+        memcpy(result, ptr, old_size < size ? old_size : size);
+    }
+    return result;
+}
+
+void allocator_free(void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    AllocHeader *header = HEADER_OF(ptr);
+    if (!(*header & HEADER_ARENA)) {
+        budget_remove((size_t)(*header & HEADER_SIZE_MASK));
+        PyMem_RawFree(header);
+    }
+}
+
+AllocatorState allocator_suspend(void) {
+    AllocatorState state = {current_arena, current_budget};
+    current_arena = NULL;
+    current_budget = NULL;
+    return state;
+}
+
+void allocator_resume(AllocatorState state) {
+    current_arena = state.arena;
+    current_budget = state.budget;
+}
+
+MemoryBudget *budget_swap(MemoryBudget *budget) {
+    MemoryBudget *previous = current_budget;
+    current_budget = budget;
+    return previous;
+}
+
+TreeArena *arena_new(void) {
+    TreeArena *arena = PyMem_Calloc(1, sizeof(TreeArena));
+    if (arena != NULL) {
+        arena->ref_count = 1;
+    }
+    return arena;
+}
+
+TreeArena *arena_retain(TreeArena *arena) {
+    if (arena != NULL) {
+        arena->ref_count += 1;
+    }
+    return arena;
+}
+
+void arena_release(TreeArena *arena) {
+    while (arena != NULL && --arena->ref_count == 0) {
+        TreeArena *parent = arena->parent;
+        ArenaChunk *chunk = arena->chunks;
+        while (chunk != NULL) {
+            ArenaChunk *next = chunk->next;
+            PyMem_Free(chunk);
+            chunk = next;
+        }
+        PyMem_Free(arena);
+        arena = parent;
+    }
+}
+
+void arena_mark_shared(TreeArena *arena) {
+    if (arena != NULL) {
+        arena->is_shared = true;
+    }
+}
+
+void arena_set_parent(TreeArena *arena, TreeArena *parent) {
+    if (parent != NULL) {
+        arena->parent = arena_retain(parent);
+        arena->is_shared = true;
+        parent->is_shared = true;
+    }
+}
+
+size_t arena_size(const TreeArena *arena) { return arena != NULL ? arena->size : 0; }
+
+TreeArena *arena_swap(TreeArena *arena) {
+    TreeArena *previous = current_arena;
+    current_arena = arena;
+    return previous;
+}
+
+void arena_delete_tree(TreeArena *arena, TSTree *tree) {
+    // A tree that never shared its memory with another tree only references
+    // blocks of its own arena, so there is no need to walk and free them.
+    if (arena == NULL || arena->ref_count > 1 || arena->is_shared) {
+        ts_tree_delete(tree);
+    }
+    arena_release(arena);
+}
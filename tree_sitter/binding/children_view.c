@@ -0,0 +1,265 @@
+#include "types.h"
+
+PyObject *node_new_internal(ModuleState *state, TSNode node, PyObject *tree);
+
+PyObject *children_view_new(ModuleState *state, Node *node, ChildrenView *all) {
+    ChildrenView *self = PyObject_New(ChildrenView, state->children_view_type);
+    if (self == NULL) {
+        return NULL;
+    }
+    // The view must not reference the node, since the node keeps a reference to the view.
+    self->node = node->node;
+    self->tree = Py_NewRef(node->tree);
+    self->all = all != NULL ? (ChildrenView *)Py_NewRef(all) : NULL;
+    self->length =
+        all != NULL ? ts_node_named_child_count(node->node) : ts_node_child_count(node->node);
+    self->children = NULL;
+    self->indices = NULL;
+    self->items = NULL;
+    return PyObject_Init((PyObject *)self, state->children_view_type);
+}
+
+void children_view_dealloc(ChildrenView *self) {
+    if (self->items != NULL) {
+        for (uint32_t i = 0; i < self->length; ++i) {
+            Py_XDECREF(self->items[i]);
+        }
+        PyMem_Free(self->items);
+    }
+    PyMem_Free(self->children);
+    PyMem_Free(self->indices);
+    Py_XDECREF(self->all);
+    Py_XDECREF(self->tree);
+    Py_TYPE(self)->tp_free(self);
+}
+
+// Collect the child nodes in one cursor pass, so that indexing is O(1) afterwards.
+static bool children_view_load(ChildrenView *self) {
+    if (self->all != NULL) {
+        if (self->indices != NULL || self->length == 0) {
+            return true;
+        }
+        if (!children_view_load(self->all)) {
+            return false;
+        }
+        self->indices = PyMem_Calloc(self->length, sizeof(uint32_t));
+        if (self->indices == NULL) {
+            PyErr_NoMemory();
+            return false;
+        }
+        for (uint32_t i = 0, j = 0; i < self->all->length && j < self->length; ++i) {
+            if (ts_node_is_named(self->all->children[i])) {
+                self->indices[j++] = i;
+            }
+        }
+        return true;
+    }
+
+    if (self->children != NULL || self->length == 0) {
+        return true;
+    }
+    self->children = PyMem_Calloc(self->length, sizeof(TSNode));
+    self->items = PyMem_Calloc(self->length, sizeof(PyObject *));
+    if (self->children == NULL || self->items == NULL) {
+        PyMem_Free(self->children);
+        PyMem_Free(self->items);
+        self->children = NULL;
+        self->items = NULL;
+        PyErr_NoMemory();
+        return false;
+    }
+    TSTreeCursor *cursor = &GET_MODULE_STATE(self)->default_cursor;
+    ts_tree_cursor_reset(cursor, self->node);
+    ts_tree_cursor_goto_first_child(cursor);
+    uint32_t i = 0;
+    do {
+        self->children[i++] = ts_tree_cursor_current_node(cursor);
+    } while (i < self->length && ts_tree_cursor_goto_next_sibling(cursor));
+    return true;
+}
+
+Py_ssize_t children_view_length(ChildrenView *self) { return self->length; }
+
+PyObject *children_view_item(ChildrenView *self, Py_ssize_t index) {
+    if (index < 0 || index >= (Py_ssize_t)self->length) {
+        PyErr_SetString(PyExc_IndexError, "child index out of range");
+        return NULL;
+    }
+    if (!children_view_load(self)) {
+        return NULL;
+    }
+    ChildrenView *all = self;
+    if (self->all != NULL) {
+        all = self->all;
+        index = self->indices[index];
+    }
+    if (all->items[index] == NULL) {
+        PyObject *child =
+            node_new_internal(GET_MODULE_STATE(self), all->children[index], all->tree);
+        if (child == NULL) {
+            return NULL;
+        }
+        all->items[index] = child;
+    }
+    return Py_NewRef(all->items[index]);
+}
+
+PyObject *children_view_subscript(ChildrenView *self, PyObject *key) {
+    if (PyIndex_Check(key)) {
+        Py_ssize_t index = PyNumber_AsSsize_t(key, PyExc_IndexError);
+        if (index == -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+        return children_view_item(self, index < 0 ? index + self->length : index);
+    }
+    if (!PySlice_Check(key)) {
+        PyErr_Format(PyExc_TypeError, "indices must be integers or slices, not %s",
+                     Py_TYPE(key)->tp_name);
+        return NULL;
+    }
+
+    Py_ssize_t start, stop, step;
+    if (PySlice_Unpack(key, &start, &stop, &step) < 0) {
+        return NULL;
+    }
+    Py_ssize_t length = PySlice_AdjustIndices(self->length, &start, &stop, step);
+    PyObject *result = PyList_New(length);
+    for (Py_ssize_t i = 0; result != NULL && i < length; ++i) {
+        PyObject *child = children_view_item(self, start + i * step);
+        if (child == NULL) {
+            Py_CLEAR(result);
+            break;
+        }
+        PyList_SET_ITEM(result, i, child);
+    }
+    return result;
+}
+
+PyObject *children_view_compare(ChildrenView *self, PyObject *other, int op) {
+    if (!PyList_Check(other) && !PyTuple_Check(other) &&
+        !PyObject_TypeCheck(other, GET_MODULE_STATE(self)->children_view_type)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    PyObject *items = PySequence_List((PyObject *)self);
+    PyObject *other_items = items != NULL ? PySequence_List(other) : NULL;
+    PyObject *result = other_items != NULL ? PyObject_RichCompare(items, other_items, op) : NULL;
+    Py_XDECREF(items);
+    Py_XDECREF(other_items);
+    return result;
+}
+
+PyObject *children_view_concat(ChildrenView *self, PyObject *other) {
+    PyObject *items = PySequence_List((PyObject *)self);
+    if (items == NULL) {
+        return NULL;
+    }
+    if (PyObject_TypeCheck(other, GET_MODULE_STATE(self)->children_view_type)) {
+        PyObject *other_items = PySequence_List(other);
+        PyObject *result = other_items != NULL ? PySequence_Concat(items, other_items) : NULL;
+        Py_DECREF(items);
+        Py_XDECREF(other_items);
+        return result;
+    }
+    PyObject *result = PySequence_Concat(items, other);
+    Py_DECREF(items);
+    return result;
+}
+
+PyObject *children_view_index(ChildrenView *self, PyObject *args) {
+    PyObject *value;
+    Py_ssize_t start = 0, stop = PY_SSIZE_T_MAX, length = self->length;
+    if (!PyArg_ParseTuple(args, "O|nn:index", &value, &start, &stop)) {
+        return NULL;
+    }
+    if (start < 0) {
+        start = start + length > 0 ? start + length : 0;
+    }
+    if (stop < 0) {
+        stop += length;
+    }
+    for (Py_ssize_t i = start; i < stop && i < length; ++i) {
+        PyObject *child = children_view_item(self, i);
+        int result = child != NULL ? PyObject_RichCompareBool(child, value, Py_EQ) : -1;
+        Py_XDECREF(child);
+        if (result != 0) {
+            return result > 0 ? PyLong_FromSsize_t(i) : NULL;
+        }
+    }
+    PyErr_SetString(PyExc_ValueError, "node is not a child");
+    return NULL;
+}
+
+PyObject *children_view_count(ChildrenView *self, PyObject *value) {
+    Py_ssize_t count = 0;
+    for (Py_ssize_t i = 0; i < (Py_ssize_t)self->length; ++i) {
+        PyObject *child = children_view_item(self, i);
+        int result = child != NULL ? PyObject_RichCompareBool(child, value, Py_EQ) : -1;
+        Py_XDECREF(child);
+        if (result < 0) {
+            return NULL;
+        }
+        count += result;
+    }
+    return PyLong_FromSsize_t(count);
+}
+
+PyObject *children_view_repr(ChildrenView *self) {
+    PyObject *items = PySequence_List((PyObject *)self);
+    if (items == NULL) {
+        return NULL;
+    }
+    PyObject *result = PyObject_Repr(items);
+    Py_DECREF(items);
+    return result;
+}
+
+PyDoc_STRVAR(children_view_index_doc,
+             "index(self, value, start=0, stop=sys.maxsize, /)\n--\n\n"
+             "Get the index of the first child that is equal to the given node." DOC_RAISES
+             "ValueError\n\n   If the node is not a child.");
+PyDoc_STRVAR(children_view_count_doc, "count(self, value, /)\n--\n\n"
+                                      "Get the number of children that are equal to the given "
+                                      "node.");
+
+static PyMethodDef children_view_methods[] = {
+    {
+        .ml_name = "index",
+        .ml_meth = (PyCFunction)children_view_index,
+        .ml_flags = METH_VARARGS,
+        .ml_doc = children_view_index_doc,
+    },
+    {
+        .ml_name = "count",
+        .ml_meth = (PyCFunction)children_view_count,
+        .ml_flags = METH_O,
+        .ml_doc = children_view_count_doc,
+    },
+    {NULL},
+};
+
+static PyType_Slot children_view_type_slots[] = {
+    {Py_tp_doc, PyDoc_STR("A read-only sequence of the children of a :class:`Node`.\n\n"
+                          "The child nodes are created when they are first accessed. "
+                          "The view is a :class:`~collections.abc.Sequence`, and adding "
+                          "it to a list or another view returns a new list.")},
+    {Py_tp_new, NULL},
+    {Py_tp_dealloc, children_view_dealloc},
+    {Py_tp_repr, children_view_repr},
+    {Py_tp_hash, PyObject_HashNotImplemented},
+    {Py_tp_richcompare, children_view_compare},
+    {Py_tp_methods, children_view_methods},
+    {Py_sq_length, children_view_length},
+    {Py_sq_concat, children_view_concat},
+    {Py_sq_item, children_view_item},
+    {Py_mp_length, children_view_length},
+    {Py_mp_subscript, children_view_subscript},
+    {0, NULL},
+};
+
+PyType_Spec children_view_type_spec = {
+    .name = "tree_sitter.ChildrenView",
+    .basicsize = sizeof(ChildrenView),
+    .itemsize = 0,
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_DISALLOW_INSTANTIATION,
+    .slots = children_view_type_slots,
+};
@@ -0,0 +1,591 @@
+#include "types.h"
+
+#include <stdlib.h>
+
+#define ENTRY_NONE UINT32_MAX
+
+const Py_buffer *tree_get_source_view(Tree *self);
+
+typedef struct {
+    uint64_t hash;
+    uint32_t size;
+    uint32_t start_byte;
+    uint32_t end_byte;
+    uint32_t first;
+    TSFieldId field;
+} Frame;
+
+typedef struct {
+    uint32_t min_size;
+    const char *text;
+    uint32_t length;
+    CloneEntry *entries;
+    uint32_t count;
+    uint32_t capacity;
+    Frame *frames;
+    uint32_t depth;
+    uint32_t frames_capacity;
+} Fingerprinter;
+
+typedef struct {
+    uint64_t hash;
+    uint32_t tree;
+    uint32_t entry;
+} Occurrence;
+
+static bool fingerprinter_enter(Fingerprinter *self, TSNode node, TSFieldId field) {
+    if (self->depth == self->frames_capacity) {
+        uint32_t capacity = self->frames_capacity ? self->frames_capacity * 2 : 64;
+        Frame *frames = PyMem_RawRealloc(self->frames, capacity * sizeof(Frame));
+        if (frames == NULL) {
+            return false;
+        }
+        self->frames = frames;
+        self->frames_capacity = capacity;
+    }
+    Frame *frame = &self->frames[self->depth++];
+    frame->hash = hash_combine(HASH_SEED, ts_node_symbol(node));
+    frame->hash = hash_combine(frame->hash, ts_node_is_missing(node));
+    frame->size = 1;
+    frame->start_byte = ts_node_start_byte(node);
+    frame->end_byte = ts_node_end_byte(node);
+    frame->first = self->count;
+    frame->field = field;
+    return true;
+}
+
+// Finish the hash of the innermost node and add it to the hash of its parent.
+static bool fingerprinter_leave(Fingerprinter *self, bool is_leaf) {
+    Frame *frame = &self->frames[--self->depth];
+    uint64_t hash = frame->hash;
+    if (is_leaf && self->text != NULL) {
+        uint32_t end_byte = frame->end_byte < self->length ? frame->end_byte : self->length;
+        if (frame->start_byte < end_byte) {
+            hash = hash_combine(hash, hash_bytes(self->text + frame->start_byte,
+                                                 end_byte - frame->start_byte));
+        }
+    }
+    hash = hash_finish(hash);
+
+    if (frame->size >= self->min_size) {
+        if (self->count == self->capacity) {
+            uint32_t capacity = self->capacity ? self->capacity * 2 : 64;
+            CloneEntry *entries = PyMem_RawRealloc(self->entries, capacity * sizeof(CloneEntry));
+            if (entries == NULL) {
+                return false;
+            }
+            self->entries = entries;
+            self->capacity = capacity;
+        }
+        // The entries of a subtree are contiguous, so the direct children can be
+        // found by skipping over the subtree of each child from the end.
+        uint32_t index = self->count++;
+        for (uint32_t child = index; child-- > frame->first;) {
+            self->entries[child].parent = index;
+            child = self->entries[child].first;
+        }
+        self->entries[index] = (CloneEntry){
+            .hash = hash,
+            .start_byte = frame->start_byte,
+            .end_byte = frame->end_byte,
+            .first = frame->first,
+            .parent = ENTRY_NONE,
+        };
+    }
+
+    if (self->depth > 0) {
+        Frame *parent = &self->frames[self->depth - 1];
+        parent->hash = hash_combine(parent->hash, frame->field);
+        parent->hash = hash_combine(parent->hash, hash);
+        parent->size += frame->size;
+    }
+    return true;
+}
+
+static bool fingerprinter_collect(Fingerprinter *self, const TSTree *tree) {
+    TSTreeCursor cursor = ts_tree_cursor_new(ts_tree_root_node(tree));
+    bool ok = fingerprinter_enter(self, ts_tree_cursor_current_node(&cursor), 0);
+    while (ok) {
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            ok = fingerprinter_enter(self, ts_tree_cursor_current_node(&cursor),
+                                     ts_tree_cursor_current_field_id(&cursor));
+            continue;
+        }
+        ok = fingerprinter_leave(self, true);
+        while (ok && !ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                goto done;
+            }
+            ok = fingerprinter_leave(self, false);
+        }
+        if (ok) {
+            ok = fingerprinter_enter(self, ts_tree_cursor_current_node(&cursor),
+                                     ts_tree_cursor_current_field_id(&cursor));
+        }
+    }
+
+done:
+    ts_tree_cursor_delete(&cursor);
+    PyMem_RawFree(self->frames);
+    if (!ok) {
+        PyMem_RawFree(self->entries);
+        self->entries = NULL;
+    }
+    return ok;
+}
+
+static inline uint32_t slot_hash(uint64_t hash) {
+    return (uint32_t)((hash * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+// A hash of zero marks an empty slot, so it is stored as one instead.
+static inline uint64_t slot_key(uint64_t hash) { return hash ? hash : 1; }
+
+static uint32_t *clone_index_count(CloneIndex *self, uint64_t hash) {
+    if (self->capacity == 0) {
+        return NULL;
+    }
+    uint64_t key = slot_key(hash);
+    uint32_t mask = self->capacity - 1;
+    uint32_t slot = slot_hash(key) & mask;
+    while (self->hashes[slot] != 0 && self->hashes[slot] != key) {
+        slot = (slot + 1) & mask;
+    }
+    return self->hashes[slot] == key ? &self->counts[slot] : NULL;
+}
+
+static bool clone_index_grow(CloneIndex *self) {
+    uint32_t capacity = self->capacity ? self->capacity * 2 : 1024;
+    uint64_t *hashes = PyMem_Calloc(capacity, sizeof(uint64_t));
+    uint32_t *counts = PyMem_Calloc(capacity, sizeof(uint32_t));
+    if (hashes == NULL || counts == NULL) {
+        PyMem_Free(hashes);
+        PyMem_Free(counts);
+        return false;
+    }
+
+    // Drop the hashes that no longer occur in any tree.
+    uint32_t size = 0;
+    for (uint32_t i = 0; i < self->capacity; ++i) {
+        if (self->hashes[i] == 0 || self->counts[i] == 0) {
+            continue;
+        }
+        uint32_t slot = slot_hash(self->hashes[i]) & (capacity - 1);
+        while (hashes[slot] != 0) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        hashes[slot] = self->hashes[i];
+        counts[slot] = self->counts[i];
+        size++;
+    }
+    PyMem_Free(self->hashes);
+    PyMem_Free(self->counts);
+    self->hashes = hashes;
+    self->counts = counts;
+    self->capacity = capacity;
+    self->size = size;
+    return true;
+}
+
+static bool clone_index_insert(CloneIndex *self, uint64_t hash) {
+    if ((self->size + 1) * 4 > self->capacity * 3 && !clone_index_grow(self)) {
+        return false;
+    }
+    uint64_t key = slot_key(hash);
+    uint32_t mask = self->capacity - 1;
+    uint32_t slot = slot_hash(key) & mask;
+    while (self->hashes[slot] != 0 && self->hashes[slot] != key) {
+        slot = (slot + 1) & mask;
+    }
+    if (self->hashes[slot] == 0) {
+        self->hashes[slot] = key;
+        self->size++;
+    }
+    self->counts[slot]++;
+    return true;
+}
+
+static void clone_index_forget(CloneIndex *self, CloneTree *tree) {
+    for (uint32_t i = 0; i < tree->count; ++i) {
+        uint32_t *count = clone_index_count(self, tree->entries[i].hash);
+        if (count != NULL && *count > 0) {
+            *count -= 1;
+        }
+    }
+    PyMem_RawFree(tree->entries);
+    tree->entries = NULL;
+    tree->count = 0;
+}
+
+static bool clone_index_remember(CloneIndex *self, CloneTree *tree, CloneEntry *entries,
+                                 uint32_t count) {
+    tree->entries = entries;
+    tree->count = count;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!clone_index_insert(self, entries[i].hash)) {
+            tree->count = i;
+            clone_index_forget(self, tree);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool clone_index_fingerprint(CloneIndex *self, Tree *tree, Fingerprinter *fingerprinter) {
+    const TSLanguage *language = ts_tree_language(tree->tree);
+    if (self->language != NULL && self->language != language) {
+        PyErr_SetString(PyExc_ValueError, "All trees must have the same language");
+        return false;
+    }
+
+    *fingerprinter = (Fingerprinter){.min_size = self->min_size};
+    // Another export keeps the source alive while the GIL is released.
+    Py_buffer source_view = {.obj = NULL};
+    if (!self->abstract_identifiers) {
+        const Py_buffer *view = tree_get_source_view(tree);
+        if (view == NULL) {
+            if (!PyErr_Occurred()) {
+                PyErr_SetString(PyExc_ValueError,
+                                "abstract_identifiers=False requires the source of the trees "
+                                "to be available");
+            }
+            return false;
+        }
+        if (PyObject_GetBuffer(view->obj, &source_view, PyBUF_SIMPLE) < 0) {
+            return false;
+        }
+        fingerprinter->text = source_view.buf;
+        fingerprinter->length = (uint32_t)source_view.len;
+    }
+
+    TSTree *copy = ts_tree_copy(tree->tree);
+    bool ok;
+    Py_BEGIN_ALLOW_THREADS
+    ok = fingerprinter_collect(fingerprinter, copy);
+    Py_END_ALLOW_THREADS
+    ts_tree_delete(copy);
+    if (source_view.obj != NULL) {
+        PyBuffer_Release(&source_view);
+    }
+    if (!ok) {
+        PyErr_NoMemory();
+        return false;
+    }
+    self->language = language;
+    return true;
+}
+
+static CloneTree *clone_index_get_tree(CloneIndex *self, PyObject *key_obj) {
+    Py_ssize_t key = PyLong_AsSsize_t(key_obj);
+    if (key == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    if (key < 0 || key >= self->tree_count || !self->trees[key].used) {
+        PyErr_SetObject(PyExc_KeyError, key_obj);
+        return NULL;
+    }
+    return &self->trees[key];
+}
+
+static int compare_occurrences(const void *lhs, const void *rhs) {
+    const Occurrence *a = lhs, *b = rhs;
+    if (a->hash != b->hash) {
+        return a->hash < b->hash ? -1 : 1;
+    }
+    if (a->tree != b->tree) {
+        return a->tree < b->tree ? -1 : 1;
+    }
+    return a->entry < b->entry ? -1 : a->entry > b->entry;
+}
+
+// A group is not reported if every one of its clones is the direct child
+// of a clone from a larger group of the same size.
+static bool clone_index_is_subsumed(CloneIndex *self, const Occurrence *group, uint32_t size) {
+    uint64_t parent_hash = 0;
+    for (uint32_t i = 0; i < size; ++i) {
+        const CloneTree *tree = &self->trees[group[i].tree];
+        uint32_t parent = tree->entries[group[i].entry].parent;
+        if (parent == ENTRY_NONE) {
+            return false;
+        }
+        uint64_t hash = tree->entries[parent].hash;
+        if (i > 0 && hash != parent_hash) {
+            return false;
+        }
+        parent_hash = hash;
+    }
+    uint32_t *count = clone_index_count(self, parent_hash);
+    return count != NULL && *count == size;
+}
+
+void clone_index_dealloc(CloneIndex *self) {
+    for (uint32_t i = 0; i < self->tree_count; ++i) {
+        PyMem_RawFree(self->trees[i].entries);
+    }
+    PyMem_Free(self->trees);
+    PyMem_Free(self->hashes);
+    PyMem_Free(self->counts);
+    Py_TYPE(self)->tp_free(self);
+}
+
+PyObject *clone_index_new(PyTypeObject *cls, PyObject *Py_UNUSED(args),
+                          PyObject *Py_UNUSED(kwargs)) {
+    CloneIndex *self = (CloneIndex *)cls->tp_alloc(cls, 0);
+    if (self != NULL) {
+        self->min_size = 10;
+        self->abstract_identifiers = true;
+        self->language = NULL;
+        self->trees = NULL;
+        self->tree_count = self->tree_capacity = 0;
+        self->hashes = NULL;
+        self->counts = NULL;
+        self->capacity = self->size = 0;
+    }
+    return (PyObject *)self;
+}
+
+int clone_index_init(CloneIndex *self, PyObject *args, PyObject *kwargs) {
+    uint32_t min_size = 10;
+    int abstract_identifiers = 1;
+    char *keywords[] = {"min_size", "abstract_identifiers", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|I$p:__init__", keywords, &min_size,
+                                     &abstract_identifiers)) {
+        return -1;
+    }
+    if (min_size == 0) {
+        PyErr_SetString(PyExc_ValueError, "min_size must be positive");
+        return -1;
+    }
+    if (self->tree_count > 0) {
+        PyErr_SetString(PyExc_RuntimeError, "The index is already initialized");
+        return -1;
+    }
+    self->min_size = min_size;
+    self->abstract_identifiers = abstract_identifiers;
+    return 0;
+}
+
+PyObject *clone_index_add(CloneIndex *self, PyObject *arg) {
+    if (!IS_INSTANCE(arg, tree_type)) {
+        PyErr_Format(PyExc_TypeError, "Expected a Tree, not %s", arg->ob_type->tp_name);
+        return NULL;
+    }
+
+    Fingerprinter fingerprinter;
+    if (!clone_index_fingerprint(self, (Tree *)arg, &fingerprinter)) {
+        return NULL;
+    }
+    if (self->tree_count == self->tree_capacity) {
+        uint32_t capacity = self->tree_capacity ? self->tree_capacity * 2 : 16;
+        CloneTree *trees = PyMem_Realloc(self->trees, capacity * sizeof(CloneTree));
+        if (trees == NULL) {
+            PyMem_RawFree(fingerprinter.entries);
+            return PyErr_NoMemory();
+        }
+        self->trees = trees;
+        self->tree_capacity = capacity;
+    }
+
+    CloneTree *tree = &self->trees[self->tree_count];
+    if (!clone_index_remember(self, tree, fingerprinter.entries, fingerprinter.count)) {
+        return PyErr_NoMemory();
+    }
+    tree->used = true;
+    return PyLong_FromUnsignedLong(self->tree_count++);
+}
+
+PyObject *clone_index_update(CloneIndex *self, PyObject *args) {
+    ModuleState *state = GET_MODULE_STATE(self);
+    PyObject *key, *tree_obj;
+    if (!PyArg_ParseTuple(args, "OO!:update", &key, state->tree_type, &tree_obj)) {
+        return NULL;
+    }
+    if (clone_index_get_tree(self, key) == NULL) {
+        return NULL;
+    }
+
+    Fingerprinter fingerprinter;
+    if (!clone_index_fingerprint(self, (Tree *)tree_obj, &fingerprinter)) {
+        return NULL;
+    }
+    // Look the tree up again, since other threads may have changed the index meanwhile.
+    CloneTree *tree = clone_index_get_tree(self, key);
+    if (tree == NULL) {
+        PyMem_RawFree(fingerprinter.entries);
+        return NULL;
+    }
+    clone_index_forget(self, tree);
+    if (!clone_index_remember(self, tree, fingerprinter.entries, fingerprinter.count)) {
+        tree->used = false;
+        return PyErr_NoMemory();
+    }
+    Py_RETURN_NONE;
+}
+
+PyObject *clone_index_remove(CloneIndex *self, PyObject *arg) {
+    CloneTree *tree = clone_index_get_tree(self, arg);
+    if (tree == NULL) {
+        return NULL;
+    }
+    clone_index_forget(self, tree);
+    tree->used = false;
+    Py_RETURN_NONE;
+}
+
+PyObject *clone_index_groups(CloneIndex *self, PyObject *Py_UNUSED(args)) {
+    size_t count = 0, capacity = 0;
+    Occurrence *occurrences = NULL;
+    for (uint32_t i = 0; i < self->tree_count; ++i) {
+        const CloneTree *tree = &self->trees[i];
+        for (uint32_t j = 0; j < tree->count; ++j) {
+            uint32_t *hash_count = clone_index_count(self, tree->entries[j].hash);
+            if (hash_count == NULL || *hash_count < 2) {
+                continue;
+            }
+            if (count == capacity) {
+                capacity = capacity ? capacity * 2 : 64;
+                Occurrence *resized = PyMem_Realloc(occurrences, capacity * sizeof(Occurrence));
+                if (resized == NULL) {
+                    PyMem_Free(occurrences);
+                    return PyErr_NoMemory();
+                }
+                occurrences = resized;
+            }
+            occurrences[count++] = (Occurrence){tree->entries[j].hash, i, j};
+        }
+    }
+    if (count > 0) {
+        qsort(occurrences, count, sizeof(Occurrence), compare_occurrences);
+    }
+
+    PyObject *result = PyList_New(0);
+    for (size_t start = 0, end; result != NULL && start < count; start = end) {
+        for (end = start + 1; end < count && occurrences[end].hash == occurrences[start].hash;) {
+            end++;
+        }
+        uint32_t size = (uint32_t)(end - start);
+        if (size < 2 || clone_index_is_subsumed(self, occurrences + start, size)) {
+            continue;
+        }
+
+        PyObject *group = PyList_New(size);
+        if (group == NULL) {
+            Py_CLEAR(result);
+            break;
+        }
+        for (uint32_t i = 0; i < size; ++i) {
+            const Occurrence *occurrence = &occurrences[start + i];
+            const CloneEntry *entry = &self->trees[occurrence->tree].entries[occurrence->entry];
+            PyObject *item =
+                Py_BuildValue("(III)", occurrence->tree, entry->start_byte, entry->end_byte);
+            if (item == NULL) {
+                Py_CLEAR(group);
+                break;
+            }
+            PyList_SET_ITEM(group, i, item);
+        }
+        if (group == NULL || PyList_Append(result, group) < 0) {
+            Py_XDECREF(group);
+            Py_CLEAR(result);
+            break;
+        }
+        Py_DECREF(group);
+    }
+    PyMem_Free(occurrences);
+    return result;
+}
+
+Py_ssize_t clone_index_length(CloneIndex *self) {
+    Py_ssize_t length = 0;
+    for (uint32_t i = 0; i < self->tree_count; ++i) {
+        length += self->trees[i].used;
+    }
+    return length;
+}
+
+PyObject *clone_index_get_min_size(CloneIndex *self, void *Py_UNUSED(payload)) {
+    return PyLong_FromUnsignedLong(self->min_size);
+}
+
+PyObject *clone_index_get_abstract_identifiers(CloneIndex *self, void *Py_UNUSED(payload)) {
+    return PyBool_FromLong(self->abstract_identifiers);
+}
+
+PyDoc_STRVAR(clone_index_add_doc,
+             "add(self, tree, /)\n--\n\n"
+             "Add the subtrees of a tree to the index." DOC_RETURNS
+             "The key of the tree, which identifies it in :meth:`groups`." DOC_NOTE
+             "The fingerprints are computed with the GIL released, so several trees can be "
+             "added in parallel threads.");
+PyDoc_STRVAR(clone_index_update_doc,
+             "update(self, key, tree, /)\n--\n\n"
+             "Replace the subtrees of the tree with the given key with those of a new tree.\n\n"
+             "Use this after a file has been reparsed.");
+PyDoc_STRVAR(clone_index_remove_doc, "remove(self, key, /)\n--\n\n"
+                                     "Remove the subtrees of the tree with the given key.");
+PyDoc_STRVAR(clone_index_groups_doc,
+             "groups(self, /)\n--\n\n"
+             "Find the groups of identical subtrees." DOC_RETURNS
+             "A list of groups, each of which is a list of ``(key, start_byte, end_byte)`` "
+             "tuples. Groups whose clones are all contained in the clones of a larger group "
+             "are omitted.");
+
+static PyMethodDef clone_index_methods[] = {
+    {
+        .ml_name = "add",
+        .ml_meth = (PyCFunction)clone_index_add,
+        .ml_flags = METH_O,
+        .ml_doc = clone_index_add_doc,
+    },
+    {
+        .ml_name = "update",
+        .ml_meth = (PyCFunction)clone_index_update,
+        .ml_flags = METH_VARARGS,
+        .ml_doc = clone_index_update_doc,
+    },
+    {
+        .ml_name = "remove",
+        .ml_meth = (PyCFunction)clone_index_remove,
+        .ml_flags = METH_O,
+        .ml_doc = clone_index_remove_doc,
+    },
+    {
+        .ml_name = "groups",
+        .ml_meth = (PyCFunction)clone_index_groups,
+        .ml_flags = METH_NOARGS,
+        .ml_doc = clone_index_groups_doc,
+    },
+    {NULL},
+};
+
+static PyGetSetDef clone_index_accessors[] = {
+    {"min_size", (getter)clone_index_get_min_size, NULL,
+     PyDoc_STR("The minimum number of nodes in an indexed subtree."), NULL},
+    {"abstract_identifiers", (getter)clone_index_get_abstract_identifiers, NULL,
+     PyDoc_STR("Whether the text of the leaf nodes is ignored."), NULL},
+    {NULL},
+};
+
+static PyType_Slot clone_index_type_slots[] = {
+    {Py_tp_doc,
+     PyDoc_STR("An index of the subtrees of many trees, used to detect syntactic clones.\n\n"
+               "Every subtree with at least ``min_size`` nodes is fingerprinted by its "
+               "structure. If ``abstract_identifiers`` is true, identifiers and other leaf "
+               "nodes are only compared by their kind, otherwise their text must match as "
+               "well." DOC_NOTE "All the trees in an index must have the same language.")},
+    {Py_tp_new, clone_index_new},
+    {Py_tp_init, clone_index_init},
+    {Py_tp_dealloc, clone_index_dealloc},
+    {Py_tp_methods, clone_index_methods},
+    {Py_tp_getset, clone_index_accessors},
+    {Py_mp_length, clone_index_length},
+    {0, NULL},
+};
+
+PyType_Spec clone_index_type_spec = {
+    .name = "tree_sitter.CloneIndex",
+    .basicsize = sizeof(CloneIndex),
+    .itemsize = 0,
+    .flags = Py_TPFLAGS_DEFAULT,
+    .slots = clone_index_type_slots,
+};
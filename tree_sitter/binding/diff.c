@@ -0,0 +1,621 @@
+#include "types.h"
+
+#include <string.h>
+
+#define NONE UINT32_MAX
+
+// The maximum number of candidates with the same hash that are compared.
+#define MAX_CANDIDATES 64
+
+void allocator_free(void *ptr);
+TreeIndex *tree_index_get(Tree *tree);
+void tree_index_hash(const TreeIndex *index, const char *text, uint32_t length,
+                     uint64_t *hashes);
+const Py_buffer *tree_get_source_view(Tree *self);
+PyObject *packed_array_new(ModuleState *state, const char *typecode, const void *data,
+                           size_t size);
+
+typedef enum {
+    DiffInsert,
+    DiffDelete,
+    DiffUpdate,
+    DiffMove,
+} DiffOperation;
+
+typedef struct {
+    const TreeIndex *old;
+    const TreeIndex *new;
+    const uint64_t *old_hashes;
+    const uint64_t *new_hashes;
+    uint32_t *old_to_new;
+    uint32_t *new_to_old;
+    // Whether a new node roots a subtree that was matched as a whole.
+    bool *whole;
+    // The number of node kinds, where the last one stands for ERROR and other out of range
+    // symbols.
+    uint32_t kind_count;
+    const TSRange *changed_ranges;
+    uint32_t changed_range_count;
+    bool has_text;
+    int32_t *script;
+    size_t script_size;
+    size_t script_capacity;
+} Differ;
+
+static inline uint32_t start_byte(const TreeIndex *index, uint32_t i) {
+    return ts_node_start_byte(index->nodes[i]);
+}
+
+static inline uint32_t end_byte(const TreeIndex *index, uint32_t i) {
+    return ts_node_end_byte(index->nodes[i]);
+}
+
+static inline TSSymbol symbol(const TreeIndex *index, uint32_t i) {
+    return ts_node_symbol(index->nodes[i]);
+}
+
+static inline bool is_matched_new(const Differ *self, uint32_t i) {
+    return self->new_to_old[i] != NONE;
+}
+
+static inline bool is_matched_old(const Differ *self, uint32_t i) {
+    return self->old_to_new[i] != NONE;
+}
+
+static inline void match(Differ *self, uint32_t old, uint32_t new) {
+    self->old_to_new[old] = new;
+    self->new_to_old[new] = old;
+}
+
+static inline uint32_t kind(const Differ *self, TSSymbol symbol) {
+    return symbol < self->kind_count - 1 ? symbol : self->kind_count - 1;
+}
+
+// Whether none of the descendants of a new node can be moved or updated, because its
+// subtree was matched as a whole to one with the same text.
+static inline bool is_identical(const Differ *self, uint32_t new) {
+    return self->whole[new] && self->has_text &&
+           self->old_hashes[self->new_to_old[new]] == self->new_hashes[new];
+}
+
+// Collect the unmatched nodes of the old tree in preorder, skipping the subtrees that were
+// matched as a whole.
+static uint32_t collect_unmatched_old(const Differ *self, uint32_t *result) {
+    uint32_t count = 0;
+    for (uint32_t old = 0; old < self->old->count;) {
+        uint32_t new = self->old_to_new[old];
+        if (new == NONE) {
+            result[count++] = old;
+        }
+        old += new != NONE && self->whole[new] ? self->old->sizes[old] : 1;
+    }
+    return count;
+}
+
+static bool is_changed(const Differ *self, uint32_t new) {
+    uint32_t start = start_byte(self->new, new), end = end_byte(self->new, new);
+    uint32_t low = 0, high = self->changed_range_count;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (self->changed_ranges[mid].end_byte < start) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low < self->changed_range_count && self->changed_ranges[low].start_byte <= end;
+}
+
+// Match two isomorphic subtrees node by node, if none of their nodes are matched yet.
+static bool match_subtrees(Differ *self, uint32_t old, uint32_t new) {
+    uint32_t size = self->old->sizes[old];
+    if (size != self->new->sizes[new]) {
+        return false;
+    }
+    for (uint32_t k = 0; k < size; ++k) {
+        if (is_matched_old(self, old + k) || is_matched_new(self, new + k) ||
+            symbol(self->old, old + k) != symbol(self->new, new + k) ||
+            self->old->sizes[old + k] != self->new->sizes[new + k]) {
+            return false;
+        }
+    }
+    for (uint32_t k = 0; k < size; ++k) {
+        match(self, old + k, new + k);
+    }
+    self->whole[new] = true;
+    return true;
+}
+
+// Walk down both trees from their roots, matching the children that start at the same
+// position. Subtrees outside of the changed ranges are identical and matched as a whole.
+static void match_unchanged(Differ *self, uint32_t *stack) {
+    const TreeIndex *old_index = self->old, *new_index = self->new;
+    if (symbol(old_index, 0) != symbol(new_index, 0)) {
+        return;
+    }
+    match(self, 0, 0);
+
+    uint32_t depth = 0;
+    stack[depth++] = 0;
+    while (depth > 0) {
+        uint32_t new = stack[--depth], old = self->new_to_old[new];
+        uint32_t old_child = old + 1, old_end = old + old_index->sizes[old];
+        uint32_t new_end = new + new_index->sizes[new];
+        for (uint32_t new_child = new + 1; new_child < new_end;
+             new_child += new_index->sizes[new_child]) {
+            uint32_t start = start_byte(new_index, new_child);
+            while (old_child < old_end && start_byte(old_index, old_child) < start) {
+                old_child += old_index->sizes[old_child];
+            }
+            if (old_child >= old_end) {
+                break;
+            }
+            if (start_byte(old_index, old_child) != start ||
+                symbol(old_index, old_child) != symbol(new_index, new_child)) {
+                continue;
+            }
+
+            bool old_leaf = old_index->sizes[old_child] == 1;
+            bool new_leaf = new_index->sizes[new_child] == 1;
+            if (!is_changed(self, new_child) || (old_leaf && new_leaf)) {
+                if (match_subtrees(self, old_child, new_child)) {
+                    continue;
+                }
+            }
+            if (!old_leaf && !new_leaf) {
+                match(self, old_child, new_child);
+                stack[depth++] = new_child;
+            }
+        }
+    }
+}
+
+// Match the remaining identical subtrees, largest first, using their structural hashes.
+static bool match_identical(Differ *self) {
+    const TreeIndex *old_index = self->old, *new_index = self->new;
+    uint32_t capacity = 16;
+    while (capacity < old_index->count * 2) {
+        capacity *= 2;
+    }
+    uint32_t mask = capacity - 1;
+    uint32_t *buckets = PyMem_Malloc(capacity * sizeof(uint32_t));
+    uint32_t *next = PyMem_Malloc(old_index->count * sizeof(uint32_t));
+    uint32_t *unmatched = PyMem_Malloc(old_index->count * sizeof(uint32_t));
+    if (buckets == NULL || next == NULL || unmatched == NULL) {
+        PyMem_Free(buckets);
+        PyMem_Free(next);
+        PyMem_Free(unmatched);
+        return false;
+    }
+    memset(buckets, 0xFF, capacity * sizeof(uint32_t));
+
+    // insert in reverse so that each chain lists the candidates in preorder
+    for (uint32_t i = collect_unmatched_old(self, unmatched); i-- > 0;) {
+        uint32_t old = unmatched[i], bucket = (uint32_t)self->old_hashes[old] & mask;
+        next[old] = buckets[bucket];
+        buckets[bucket] = old;
+    }
+
+    for (uint32_t new = 0; new < new_index->count;) {
+        if (is_matched_new(self, new)) {
+            new += self->whole[new] ? new_index->sizes[new] : 1;
+            continue;
+        }
+
+        uint64_t hash = self->new_hashes[new];
+        uint32_t new_parent = new_index->parents[new];
+        uint32_t preferred_parent = new_parent != NONE ? self->new_to_old[new_parent] : NONE;
+        uint32_t candidate = NONE, remaining = MAX_CANDIDATES;
+        for (uint32_t old = buckets[(uint32_t)hash & mask]; old != NONE && remaining > 0;
+             old = next[old]) {
+            if (self->old_hashes[old] != hash || is_matched_old(self, old)) {
+                continue;
+            }
+            remaining -= 1;
+            if (candidate == NONE || (preferred_parent != NONE &&
+                                      old_index->parents[old] == preferred_parent)) {
+                candidate = old;
+            }
+            if (preferred_parent == NONE || old_index->parents[old] == preferred_parent) {
+                break;
+            }
+        }
+
+        if (candidate != NONE && match_subtrees(self, candidate, new)) {
+            new += new_index->sizes[new];
+        } else {
+            new += 1;
+        }
+    }
+
+    PyMem_Free(buckets);
+    PyMem_Free(next);
+    PyMem_Free(unmatched);
+    return true;
+}
+
+// Match the remaining inner nodes whose children were mostly matched to the children of
+// the same old node, and then the remaining children of matched nodes by their kind.
+static bool match_containers(Differ *self) {
+    const TreeIndex *old_index = self->old, *new_index = self->new;
+    uint32_t *unmatched = PyMem_Malloc(new_index->count * sizeof(uint32_t));
+    uint32_t *votes = PyMem_Calloc(old_index->count, sizeof(uint32_t));
+    uint32_t *next = PyMem_Malloc(old_index->count * sizeof(uint32_t));
+    uint32_t *heads = PyMem_Malloc(self->kind_count * sizeof(uint32_t));
+    uint32_t *tails = PyMem_Malloc(self->kind_count * sizeof(uint32_t));
+    bool ok = unmatched && votes && next && heads && tails;
+    if (!ok) {
+        goto cleanup;
+    }
+
+    uint32_t count = 0;
+    for (uint32_t new = 0; new < new_index->count;) {
+        if (!is_matched_new(self, new)) {
+            unmatched[count++] = new;
+        }
+        new += self->whole[new] ? new_index->sizes[new] : 1;
+    }
+
+    // Children come after their parent in preorder, so the children are matched first.
+    for (uint32_t i = count; i-- > 0;) {
+        uint32_t new = unmatched[i];
+        if (new_index->sizes[new] == 1) {
+            continue;
+        }
+        uint32_t end = new + new_index->sizes[new];
+        for (uint32_t child = new + 1; child < end; child += new_index->sizes[child]) {
+            uint32_t candidate =
+                is_matched_new(self, child) ? old_index->parents[self->new_to_old[child]] : NONE;
+            if (candidate != NONE) {
+                votes[candidate] += 1;
+            }
+        }
+
+        // Take the first candidate with the most votes, and reset the votes along the way.
+        uint32_t best = NONE, best_votes = 0;
+        for (uint32_t child = new + 1; child < end; child += new_index->sizes[child]) {
+            uint32_t candidate =
+                is_matched_new(self, child) ? old_index->parents[self->new_to_old[child]] : NONE;
+            if (candidate == NONE) {
+                continue;
+            }
+            uint32_t candidate_votes = votes[candidate];
+            votes[candidate] = 0;
+            if (candidate_votes > best_votes && !is_matched_old(self, candidate) &&
+                symbol(old_index, candidate) == symbol(new_index, new)) {
+                best = candidate;
+                best_votes = candidate_votes;
+            }
+        }
+        if (best != NONE) {
+            match(self, best, new);
+        }
+    }
+
+    memset(heads, 0xFF, self->kind_count * sizeof(uint32_t));
+    for (uint32_t new = 0; new < new_index->count;) {
+        if (!is_matched_new(self, new) || self->whole[new]) {
+            new += is_matched_new(self, new) ? new_index->sizes[new] : 1;
+            continue;
+        }
+        uint32_t old = self->new_to_old[new];
+        uint32_t old_end = old + old_index->sizes[old];
+
+        // Queue the unmatched old children by their kind, so that each one is visited once.
+        for (uint32_t old_child = old + 1; old_child < old_end;
+             old_child += old_index->sizes[old_child]) {
+            if (is_matched_old(self, old_child)) {
+                continue;
+            }
+            uint32_t k = kind(self, symbol(old_index, old_child));
+            next[old_child] = NONE;
+            if (heads[k] == NONE) {
+                heads[k] = old_child;
+            } else {
+                next[tails[k]] = old_child;
+            }
+            tails[k] = old_child;
+        }
+
+        // The matches keep their order, so the candidates before the last match are dropped.
+        uint32_t old_child = old + 1;
+        uint32_t new_end = new + new_index->sizes[new];
+        for (uint32_t new_child = new + 1; new_child < new_end;
+             new_child += new_index->sizes[new_child]) {
+            if (is_matched_new(self, new_child)) {
+                continue;
+            }
+            uint32_t k = kind(self, symbol(new_index, new_child));
+            uint32_t candidate = heads[k];
+            while (candidate != NONE && candidate < old_child) {
+                candidate = next[candidate];
+            }
+            heads[k] = candidate;
+            if (candidate != NONE) {
+                match(self, candidate, new_child);
+                old_child = candidate + old_index->sizes[candidate];
+                heads[k] = next[candidate];
+            }
+        }
+
+        for (uint32_t child = old + 1; child < old_end; child += old_index->sizes[child]) {
+            heads[kind(self, symbol(old_index, child))] = NONE;
+        }
+        new += 1;
+    }
+
+cleanup:
+    PyMem_Free(unmatched);
+    PyMem_Free(votes);
+    PyMem_Free(next);
+    PyMem_Free(heads);
+    PyMem_Free(tails);
+    return ok;
+}
+
+static bool emit(Differ *self, DiffOperation operation, uint32_t old, uint32_t new) {
+    if (self->script_size + 3 > self->script_capacity) {
+        size_t capacity = self->script_capacity ? self->script_capacity * 2 : 96;
+        int32_t *script = PyMem_Realloc(self->script, capacity * sizeof(int32_t));
+        if (script == NULL) {
+            return false;
+        }
+        self->script = script;
+        self->script_capacity = capacity;
+    }
+    self->script[self->script_size++] = (int32_t)operation;
+    self->script[self->script_size++] = old == NONE ? -1 : (int32_t)old;
+    self->script[self->script_size++] = new == NONE ? -1 : (int32_t)new;
+    return true;
+}
+
+static bool is_updated(const Differ *self, uint32_t old, uint32_t new) {
+    const TreeIndex *old_index = self->old, *new_index = self->new;
+    if (old_index->sizes[old] != 1 || new_index->sizes[new] != 1) {
+        return false;
+    }
+    if (self->has_text) {
+        return self->old_hashes[old] != self->new_hashes[new];
+    }
+    return ts_node_has_changes(old_index->nodes[old]) ||
+           end_byte(old_index, old) - start_byte(old_index, old) !=
+               end_byte(new_index, new) - start_byte(new_index, new);
+}
+
+// Mark the matched children that stay under the same parent but leave the longest
+// increasing subsequence of their old positions as moved.
+static void mark_reordered(const Differ *self, uint32_t new, uint32_t *children, uint32_t *tails,
+                           uint32_t *previous, bool *moved) {
+    const TreeIndex *new_index = self->new;
+    uint32_t old_parent = self->new_to_old[new];
+    uint32_t count = 0, length = 0;
+    uint32_t end = new + new_index->sizes[new];
+    for (uint32_t child = new + 1; child < end; child += new_index->sizes[child]) {
+        if (is_matched_new(self, child) &&
+            self->old->parents[self->new_to_old[child]] == old_parent) {
+            children[count++] = child;
+        }
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t value = self->new_to_old[children[i]];
+        uint32_t low = 0, high = length;
+        while (low < high) {
+            uint32_t mid = low + (high - low) / 2;
+            if (self->new_to_old[children[tails[mid]]] < value) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        previous[i] = low > 0 ? tails[low - 1] : NONE;
+        tails[low] = i;
+        if (low == length) {
+            length += 1;
+        }
+        moved[children[i]] = true;
+    }
+    for (uint32_t i = length > 0 ? tails[length - 1] : NONE; i != NONE; i = previous[i]) {
+        moved[children[i]] = false;
+    }
+}
+
+static bool build_script(Differ *self) {
+    const TreeIndex *old_index = self->old, *new_index = self->new;
+    uint32_t count = new_index->count;
+    uint32_t *children = PyMem_Malloc(count * sizeof(uint32_t));
+    uint32_t *tails = PyMem_Malloc(count * sizeof(uint32_t));
+    uint32_t *previous = PyMem_Malloc(count * sizeof(uint32_t));
+    uint32_t *unmatched = PyMem_Malloc(old_index->count * sizeof(uint32_t));
+    bool *moved = PyMem_Calloc(count, sizeof(bool));
+    bool ok = children && tails && previous && unmatched && moved;
+
+    for (uint32_t new = 0; ok && new < count;) {
+        if (is_matched_new(self, new) && is_identical(self, new)) {
+            new += new_index->sizes[new];
+            continue;
+        }
+        if (is_matched_new(self, new) && new_index->sizes[new] > 1) {
+            mark_reordered(self, new, children, tails, previous, moved);
+        }
+        new += 1;
+    }
+
+    for (uint32_t new = 0; ok && new < count;) {
+        uint32_t old = self->new_to_old[new];
+        if (old == NONE) {
+            ok = emit(self, DiffInsert, NONE, new);
+            new += 1;
+            continue;
+        }
+        uint32_t new_parent = new_index->parents[new], old_parent = old_index->parents[old];
+        if (new_parent != NONE &&
+            (self->new_to_old[new_parent] != old_parent || moved[new])) {
+            ok = emit(self, DiffMove, old, new);
+        }
+        if (ok && is_updated(self, old, new)) {
+            ok = emit(self, DiffUpdate, old, new);
+        }
+        new += is_identical(self, new) ? new_index->sizes[new] : 1;
+    }
+
+    for (uint32_t i = ok ? collect_unmatched_old(self, unmatched) : 0; ok && i-- > 0;) {
+        ok = emit(self, DiffDelete, unmatched[i], NONE);
+    }
+
+    PyMem_Free(children);
+    PyMem_Free(tails);
+    PyMem_Free(previous);
+    PyMem_Free(unmatched);
+    PyMem_Free(moved);
+    return ok;
+}
+
+// Take another export of the source of a tree, if the source is available.
+static bool acquire_text(Tree *tree, Py_buffer *text) {
+    const Py_buffer *view = tree_get_source_view(tree);
+    if (view == NULL) {
+        return !PyErr_Occurred();
+    }
+    if (PyObject_GetBuffer(view->obj, text, PyBUF_SIMPLE) < 0) {
+        text->obj = NULL;
+        return false;
+    }
+    return true;
+}
+
+// Reuse the hashes of the index if they were computed the same way. Otherwise, compute them
+// into a buffer of their own, so that the hashes requested with Tree.compute_hashes are kept.
+static const uint64_t *prepare_hashes(const TreeIndex *index, const Py_buffer *text,
+                                      uint64_t **buffer) {
+    if (index->hashes != NULL && index->hashes_include_text == (text != NULL)) {
+        return index->hashes;
+    }
+    *buffer = PyMem_Malloc(index->count * sizeof(uint64_t));
+    if (*buffer == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    tree_index_hash(index, text != NULL ? text->buf : NULL,
+                    text != NULL ? (uint32_t)text->len : 0, *buffer);
+    return *buffer;
+}
+
+PyObject *diff(PyObject *module, PyObject *args, PyObject *kwargs) {
+    ModuleState *state = PyModule_GetState(module);
+    Tree *old_tree, *new_tree;
+    char *keywords[] = {"old_tree", "new_tree", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!O!:diff", keywords, state->tree_type,
+                                     &old_tree, state->tree_type, &new_tree)) {
+        return NULL;
+    }
+
+    // The source is read before the indices, since a read callback could edit either tree.
+    // Leaf text can only be compared if the source of both trees is available.
+    PyObject *result = NULL;
+    Py_buffer old_text = {.obj = NULL}, new_text = {.obj = NULL};
+    uint64_t *old_hashes = NULL, *new_hashes = NULL;
+    Differ self = {.old_to_new = NULL};
+    uint32_t *stack = NULL;
+    TSRange *changed_ranges = NULL;
+    if (!acquire_text(old_tree, &old_text) || !acquire_text(new_tree, &new_text)) {
+        goto cleanup;
+    }
+    bool has_text = old_text.obj != NULL && new_text.obj != NULL;
+
+    TreeIndex *old_index = tree_index_get(old_tree);
+    TreeIndex *new_index = old_index != NULL ? tree_index_get(new_tree) : NULL;
+    if (new_index == NULL) {
+        goto cleanup;
+    }
+    self.old_hashes = prepare_hashes(old_index, has_text ? &old_text : NULL, &old_hashes);
+    self.new_hashes = self.old_hashes != NULL
+                          ? prepare_hashes(new_index, has_text ? &new_text : NULL, &new_hashes)
+                          : NULL;
+    if (self.new_hashes == NULL) {
+        goto cleanup;
+    }
+
+    uint32_t old_kind_count = ts_language_symbol_count(ts_tree_language(old_tree->tree));
+    uint32_t new_kind_count = ts_language_symbol_count(ts_tree_language(new_tree->tree));
+    self.old = old_index;
+    self.new = new_index;
+    self.kind_count = (old_kind_count > new_kind_count ? old_kind_count : new_kind_count) + 1;
+    self.has_text = has_text;
+    self.old_to_new = PyMem_Malloc(old_index->count * sizeof(uint32_t));
+    self.new_to_old = PyMem_Malloc(new_index->count * sizeof(uint32_t));
+    self.whole = PyMem_Calloc(new_index->count, sizeof(bool));
+    stack = PyMem_Malloc(new_index->count * sizeof(uint32_t));
+    changed_ranges =
+        ts_tree_get_changed_ranges(old_tree->tree, new_tree->tree, &self.changed_range_count);
+    self.changed_ranges = changed_ranges;
+
+    if (self.old_to_new == NULL || self.new_to_old == NULL || self.whole == NULL ||
+        stack == NULL) {
+        PyErr_NoMemory();
+        goto cleanup;
+    }
+    memset(self.old_to_new, 0xFF, old_index->count * sizeof(uint32_t));
+    memset(self.new_to_old, 0xFF, new_index->count * sizeof(uint32_t));
+
+    match_unchanged(&self, stack);
+    if (!match_identical(&self)) {
+        PyErr_NoMemory();
+        goto cleanup;
+    }
+    if (!match_containers(&self) || !build_script(&self)) {
+        PyErr_NoMemory();
+        goto cleanup;
+    }
+
+    result = packed_array_new(state, "i", self.script, self.script_size * sizeof(int32_t));
+
+cleanup:
+    PyMem_Free(self.old_to_new);
+    PyMem_Free(self.new_to_old);
+    PyMem_Free(self.whole);
+    PyMem_Free(self.script);
+    PyMem_Free(stack);
+    PyMem_Free(old_hashes);
+    PyMem_Free(new_hashes);
+    if (changed_ranges != NULL) {
+        allocator_free(changed_ranges);
+    }
+    if (old_text.obj != NULL) {
+        PyBuffer_Release(&old_text);
+    }
+    if (new_text.obj != NULL) {
+        PyBuffer_Release(&new_text);
+    }
+    return result;
+}
+
+PyDoc_STRVAR(
+    diff_doc,
+    "diff(old_tree, new_tree)\n--\n\n"
+    "Compute an edit script that transforms the nodes of one syntax tree into another.\n\n"
+    "The nodes of the two trees are matched in three phases. Subtrees outside of the "
+    ":meth:`Tree.changed_ranges` are matched by position, the remaining identical subtrees are "
+    "matched by their structural hashes, and the nodes that are left are matched by their kind "
+    "and by the matches of their children." DOC_RETURNS
+    "An :class:`array.array` of signed integers, where every three items represent an "
+    "operation: a :class:`DiffOperation`, the index of the node in the old tree and the index "
+    "of the node in the new tree. Missing indices are ``-1``." DOC_NOTE
+    "Node indices are the preorder indices used by :meth:`TreeCursor.goto_descendant`.\n\n"
+    "If the source of both trees is available, leaf nodes with a different text are reported "
+    "as updated. Otherwise, only the leaves that were edited or changed size are.\n\n"
+    "The hashes set by :meth:`Tree.compute_hashes` are used if they match, and are never "
+    "replaced." DOC_TIP
+    "For the changed ranges to narrow the work down, the old tree must have been edited "
+    "and passed to :meth:`Parser.parse` to produce the new tree. Editing a tree drops its "
+    "source, so in this workflow the text of the leaves is never compared.");
+
+PyMethodDef diff_methods[] = {
+    {
+        .ml_name = "diff",
+        .ml_meth = (PyCFunction)diff,
+        .ml_flags = METH_VARARGS | METH_KEYWORDS,
+        .ml_doc = diff_doc,
+    },
+    {NULL},
+};
@@ -1,13 +1,51 @@
 #include "types.h"
 
+// ts_builtin_sym_error and ts_builtin_sym_error_repeat, counting down from UINT16_MAX
+#define BUILTIN_ERROR_COUNT 2
+
+// The cached names and name tables are sized for the language, so they are
+// dropped whenever the language is replaced.
+static void language_clear(Language *self) {
+    if (self->kind_names != NULL) {
+        uint32_t kind_count = ts_language_symbol_count(self->language);
+        for (uint32_t i = 0; i < kind_count; ++i) {
+            Py_XDECREF(self->kind_names[i]);
+        }
+        PyMem_Free(self->kind_names);
+        self->kind_names = NULL;
+    }
+    if (self->field_names != NULL) {
+        uint32_t field_count = ts_language_field_count(self->language);
+        for (uint32_t i = 0; i <= field_count; ++i) {
+            Py_XDECREF(self->field_names[i]);
+        }
+        PyMem_Free(self->field_names);
+        self->field_names = NULL;
+    }
+    if (self->error_names != NULL) {
+        for (uint32_t i = 0; i < BUILTIN_ERROR_COUNT; ++i) {
+            Py_XDECREF(self->error_names[i]);
+        }
+        PyMem_Free(self->error_names);
+        self->error_names = NULL;
+    }
+    PyMem_Free(self->kind_ids.slots);
+    self->kind_ids = (NameTable){0};
+    PyMem_Free(self->field_ids.slots);
+    self->field_ids = (NameTable){0};
+    ts_language_delete(self->language);
+    self->language = NULL;
+}
+
 int language_init(Language *self, PyObject *args, PyObject *Py_UNUSED(kwargs)) {
     PyObject *language;
     if (!PyArg_ParseTuple(args, "O:__init__", &language)) {
         return -1;
     }
 
+    TSLanguage *ts_language;
     if (PyCapsule_CheckExact(language)) {
-        self->language = PyCapsule_GetPointer(language, "tree_sitter.Language");
+        ts_language = PyCapsule_GetPointer(language, "tree_sitter.Language");
     } else {
         Py_uintptr_t language_id = PyLong_AsSize_t(language);
         if (language_id == 0 || (language_id % sizeof(TSLanguage *)) != 0) {
@@ -19,22 +57,173 @@ int language_init(Language *self, PyObject *args, PyObject *Py_UNUSED(kwargs)) {
         if (DEPRECATE("int argument support is deprecated") < 0) {
             return -1;
         }
-        self->language = PyLong_AsVoidPtr(language);
+        ts_language = PyLong_AsVoidPtr(language);
     }
 
-    if (self->language == NULL) {
+    if (ts_language == NULL) {
         return -1;
     }
+    if (ts_language != self->language) {
+        language_clear(self);
+        self->language = ts_language;
+    }
     self->abi_version = ts_language_abi_version(self->language);
     self->name = ts_language_name(self->language);
     return 0;
 }
 
 void language_dealloc(Language *self) {
-    ts_language_delete(self->language);
+    language_clear(self);
     Py_TYPE(self)->tp_free(self);
 }
 
+// The names are interned and cached, so that they can be compared by identity.
+static PyObject *interned_name(PyObject ***table, uint32_t size, uint32_t id, const char *name) {
+    if (name == NULL) {
+        Py_RETURN_NONE;
+    }
+    if (*table == NULL) {
+        *table = PyMem_Calloc(size, sizeof(PyObject *));
+        if (*table == NULL) {
+            return PyErr_NoMemory();
+        }
+    }
+    if ((*table)[id] == NULL) {
+        (*table)[id] = PyUnicode_InternFromString(name);
+        if ((*table)[id] == NULL) {
+            return NULL;
+        }
+    }
+    return Py_NewRef((*table)[id]);
+}
+
+PyObject *language_kind_name(Language *self, TSSymbol symbol) {
+    uint32_t kind_count = ts_language_symbol_count(self->language);
+    if (symbol >= kind_count) {
+        // the builtin error symbols are outside of the symbol table
+        uint32_t error_id = UINT16_MAX - symbol;
+        if (error_id >= BUILTIN_ERROR_COUNT) {
+            Py_RETURN_NONE;
+        }
+        return interned_name(&self->error_names, BUILTIN_ERROR_COUNT, error_id,
+                             ts_language_symbol_name(self->language, symbol));
+    }
+    return interned_name(&self->kind_names, kind_count, symbol,
+                         ts_language_symbol_name(self->language, symbol));
+}
+
+PyObject *language_field_name(Language *self, TSFieldId field_id) {
+    uint32_t field_count = ts_language_field_count(self->language);
+    if (field_id == 0 || field_id > field_count) {
+        Py_RETURN_NONE;
+    }
+    return interned_name(&self->field_names, field_count + 1, field_id,
+                         ts_language_field_name_for_id(self->language, field_id));
+}
+
+// The field names that the library returns point into the language,
+// so they can be matched to their ids by address.
+PyObject *language_field_name_for_string(Language *self, const char *field_name) {
+    if (field_name == NULL) {
+        Py_RETURN_NONE;
+    }
+    uint32_t field_count = ts_language_field_count(self->language);
+    for (TSFieldId field_id = 1; field_id <= field_count; ++field_id) {
+        if (ts_language_field_name_for_id(self->language, field_id) == field_name) {
+            return language_field_name(self, field_id);
+        }
+    }
+    return PyUnicode_FromString(field_name);
+}
+
+static inline uint32_t name_hash(const char *name, uint32_t length, bool is_named) {
+    return (uint32_t)hash_finish(hash_combine(hash_bytes(name, length), is_named));
+}
+
+static NameSlot *name_table_find(const NameTable *table, const char *name, uint32_t length,
+                                 bool is_named) {
+    uint32_t slot = name_hash(name, length, is_named) & table->mask;
+    while (table->slots[slot].name != NULL) {
+        NameSlot *entry = &table->slots[slot];
+        if (entry->length == length && entry->is_named == is_named &&
+            memcmp(entry->name, name, length) == 0) {
+            return entry;
+        }
+        slot = (slot + 1) & table->mask;
+    }
+    return &table->slots[slot];
+}
+
+static bool name_table_init(NameTable *table, uint32_t count) {
+    uint32_t capacity = 16;
+    while (capacity < count * 2) {
+        capacity *= 2;
+    }
+    table->slots = PyMem_Calloc(capacity, sizeof(NameSlot));
+    table->mask = capacity - 1;
+    return table->slots != NULL;
+}
+
+// Keep the first id for each name, which is the one that the library would find.
+static void name_table_insert(NameTable *table, const char *name, uint16_t id, bool is_named) {
+    uint32_t length = (uint32_t)strlen(name);
+    NameSlot *slot = name_table_find(table, name, length, is_named);
+    if (slot->name == NULL) {
+        *slot = (NameSlot){.name = name, .length = length, .id = id, .is_named = is_named};
+    }
+}
+
+static bool language_build_kind_ids(Language *self) {
+    uint32_t kind_count = ts_language_symbol_count(self->language);
+    if (!name_table_init(&self->kind_ids, kind_count)) {
+        return false;
+    }
+    for (TSSymbol symbol = 0; symbol < kind_count; ++symbol) {
+        TSSymbolType symbol_type = ts_language_symbol_type(self->language, symbol);
+        const char *name = ts_language_symbol_name(self->language, symbol);
+        if (symbol_type != TSSymbolTypeAuxiliary && name != NULL) {
+            name_table_insert(&self->kind_ids, name, symbol, symbol_type != TSSymbolTypeAnonymous);
+        }
+    }
+    return true;
+}
+
+static bool language_build_field_ids(Language *self) {
+    uint32_t field_count = ts_language_field_count(self->language);
+    if (!name_table_init(&self->field_ids, field_count)) {
+        return false;
+    }
+    for (TSFieldId field_id = 1; field_id <= field_count; ++field_id) {
+        const char *name = ts_language_field_name_for_id(self->language, field_id);
+        if (name != NULL) {
+            name_table_insert(&self->field_ids, name, field_id, false);
+        }
+    }
+    return true;
+}
+
+// Name lookups in the library scan the whole symbol table, so they go through
+// hash tables that are built on first use. If those cannot be allocated,
+// the library is used instead.
+TSSymbol language_symbol_for_name(Language *self, const char *name, uint32_t length,
+                                  bool is_named) {
+    // the library answers "ERROR", or any prefix of it, before looking at is_named
+    bool is_error = length <= 5 && memcmp(name, "ERROR", length) == 0;
+    if (is_error || (self->kind_ids.slots == NULL && !language_build_kind_ids(self))) {
+        return ts_language_symbol_for_name(self->language, name, length, is_named);
+    }
+    NameSlot *slot = name_table_find(&self->kind_ids, name, length, is_named);
+    return slot->name != NULL ? slot->id : 0;
+}
+
+TSFieldId language_field_id(Language *self, const char *name, uint32_t length) {
+    if (self->field_ids.slots == NULL && !language_build_field_ids(self)) {
+        return ts_language_field_id_for_name(self->language, name, length);
+    }
+    NameSlot *slot = name_table_find(&self->field_ids, name, length, false);
+    return slot->name != NULL ? slot->id : 0;
+}
+
 PyObject *language_repr(Language *self) {
     if (self->name == NULL) {
         return PyUnicode_FromFormat("<Language id=%" PRIuPTR ", version=%u, name=None>",
@@ -107,9 +296,9 @@ PyObject *language_get_supertypes(Language *self, void *Py_UNUSED(payload)) {
     return result;
 }
 
-PyObject *language_subtypes(Language *self, PyObject *args) {
+PyObject *language_subtypes(Language *self, PyObject *arg) {
     TSSymbol supertype;
-    if (!PyArg_ParseTuple(args, "H:subtypes", &supertype)) {
+    if (!arg_as_uint16(arg, &supertype)) {
         return NULL;
     }
     uint32_t length;
@@ -124,97 +313,92 @@ PyObject *language_subtypes(Language *self, PyObject *args) {
     return result;
 }
 
-PyObject *language_node_kind_for_id(Language *self, PyObject *args) {
+PyObject *language_node_kind_for_id(Language *self, PyObject *arg) {
     TSSymbol symbol;
-    if (!PyArg_ParseTuple(args, "H:node_kind_for_id", &symbol)) {
+    if (!arg_as_uint16(arg, &symbol)) {
         return NULL;
     }
-    const char *name = ts_language_symbol_name(self->language, symbol);
-    if (name == NULL) {
-        Py_RETURN_NONE;
-    }
-    return PyUnicode_FromString(name);
+    return language_kind_name(self, symbol);
 }
 
-PyObject *language_id_for_node_kind(Language *self, PyObject *args) {
-    char *kind;
+PyObject *language_id_for_node_kind(Language *self, PyObject *const *args, Py_ssize_t nargs) {
+    if (!check_arg_count("id_for_node_kind", nargs, 2)) {
+        return NULL;
+    }
     Py_ssize_t length;
-    int named;
-    if (!PyArg_ParseTuple(args, "s#p:id_for_node_kind", &kind, &length, &named)) {
+    const char *kind = arg_as_utf8(args[0], &length);
+    int named = kind != NULL ? PyObject_IsTrue(args[1]) : -1;
+    if (named < 0) {
         return NULL;
     }
-    TSSymbol symbol = ts_language_symbol_for_name(self->language, kind, (uint32_t)length, named);
+    TSSymbol symbol = language_symbol_for_name(self, kind, (uint32_t)length, named);
     if (symbol == 0) {
         Py_RETURN_NONE;
     }
     return PyLong_FromUnsignedLong(symbol);
 }
 
-PyObject *language_node_kind_is_named(Language *self, PyObject *args) {
+PyObject *language_node_kind_is_named(Language *self, PyObject *arg) {
     TSSymbol symbol;
-    if (!PyArg_ParseTuple(args, "H:node_kind_is_named", &symbol)) {
+    if (!arg_as_uint16(arg, &symbol)) {
         return NULL;
     }
     TSSymbolType symbol_type = ts_language_symbol_type(self->language, symbol);
     return PyBool_FromLong(symbol_type == TSSymbolTypeRegular);
 }
 
-PyObject *language_node_kind_is_visible(Language *self, PyObject *args) {
+PyObject *language_node_kind_is_visible(Language *self, PyObject *arg) {
     TSSymbol symbol;
-    if (!PyArg_ParseTuple(args, "H:node_kind_is_visible", &symbol)) {
+    if (!arg_as_uint16(arg, &symbol)) {
         return NULL;
     }
     TSSymbolType symbol_type = ts_language_symbol_type(self->language, symbol);
     return PyBool_FromLong(symbol_type <= TSSymbolTypeAnonymous);
 }
 
-PyObject *language_node_kind_is_supertype(Language *self, PyObject *args) {
+PyObject *language_node_kind_is_supertype(Language *self, PyObject *arg) {
     TSSymbol symbol;
-    if (!PyArg_ParseTuple(args, "H:node_kind_is_supertype", &symbol)) {
+    if (!arg_as_uint16(arg, &symbol)) {
         return NULL;
     }
     TSSymbolType symbol_type = ts_language_symbol_type(self->language, symbol);
     return PyBool_FromLong(symbol_type <= TSSymbolTypeSupertype);
 }
 
-PyObject *language_field_name_for_id(Language *self, PyObject *args) {
+PyObject *language_field_name_for_id(Language *self, PyObject *arg) {
     uint16_t field_id;
-    if (!PyArg_ParseTuple(args, "H:field_name_for_id", &field_id)) {
+    if (!arg_as_uint16(arg, &field_id)) {
         return NULL;
     }
-    const char *field_name = ts_language_field_name_for_id(self->language, field_id);
-    if (field_name == NULL) {
-        Py_RETURN_NONE;
-    }
-    return PyUnicode_FromString(field_name);
+    return language_field_name(self, field_id);
 }
 
-PyObject *language_field_id_for_name(Language *self, PyObject *args) {
-    char *field_name;
+PyObject *language_field_id_for_name(Language *self, PyObject *arg) {
     Py_ssize_t length;
-    if (!PyArg_ParseTuple(args, "s#:field_id_for_name", &field_name, &length)) {
+    const char *field_name = arg_as_utf8(arg, &length);
+    if (field_name == NULL) {
         return NULL;
     }
-    TSFieldId field_id =
-        ts_language_field_id_for_name(self->language, field_name, (uint32_t)length);
+    TSFieldId field_id = language_field_id(self, field_name, (uint32_t)length);
     if (field_id == 0) {
         Py_RETURN_NONE;
     }
     return PyLong_FromUnsignedLong(field_id);
 }
 
-PyObject *language_next_state(Language *self, PyObject *args) {
+PyObject *language_next_state(Language *self, PyObject *const *args, Py_ssize_t nargs) {
     uint16_t state_id, symbol;
-    if (!PyArg_ParseTuple(args, "HH:next_state", &state_id, &symbol)) {
+    if (!check_arg_count("next_state", nargs, 2) || !arg_as_uint16(args[0], &state_id) ||
+        !arg_as_uint16(args[1], &symbol)) {
         return NULL;
     }
     TSStateId state = ts_language_next_state(self->language, state_id, symbol);
     return PyLong_FromUnsignedLong(state);
 }
 
-PyObject *language_lookahead_iterator(Language *self, PyObject *args) {
+PyObject *language_lookahead_iterator(Language *self, PyObject *arg) {
     uint16_t state_id;
-    if (!PyArg_ParseTuple(args, "H:lookahead_iterator", &state_id)) {
+    if (!arg_as_uint16(arg, &state_id)) {
         return NULL;
     }
     TSLookaheadIterator *lookahead_iterator = ts_lookahead_iterator_new(self->language, state_id);
@@ -238,9 +422,62 @@ PyObject *language_copy(Language *self, PyObject *Py_UNUSED(args)) {
         return NULL;
     }
     copied->language = (TSLanguage *)ts_language_copy(self->language);
+    copied->kind_names = NULL;
+    copied->field_names = NULL;
+    copied->error_names = NULL;
+    copied->kind_ids = copied->field_ids = (NameTable){NULL, 0};
     return PyObject_Init((PyObject *)copied, state->language_type);
 }
 
+// Build a lookup table from an iterable of kind ids or kind names.
+// A name matches both the named and the anonymous kinds that share it.
+bool *language_kind_set_new(Language *self, PyObject *kinds) {
+    uint32_t kind_count = ts_language_symbol_count(self->language);
+    bool *kind_set = PyMem_RawCalloc(kind_count ? kind_count : 1, sizeof(bool));
+    if (kind_set == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    PyObject *iterator = PyObject_GetIter(kinds), *item;
+    if (iterator == NULL) {
+        PyMem_RawFree(kind_set);
+        return NULL;
+    }
+    while ((item = PyIter_Next(iterator)) != NULL) {
+        if (PyUnicode_Check(item)) {
+            Py_ssize_t length;
+            const char *name = PyUnicode_AsUTF8AndSize(item, &length);
+            bool found = false;
+            for (int is_named = 0; name != NULL && is_named < 2; ++is_named) {
+                TSSymbol symbol = language_symbol_for_name(self, name, (uint32_t)length, is_named);
+                if (symbol != 0 && symbol < kind_count) {
+                    kind_set[symbol] = found = true;
+                }
+            }
+            if (name != NULL && !found) {
+                PyErr_Format(PyExc_ValueError, "Invalid node kind: %s", name);
+            }
+        } else {
+            unsigned long kind = PyLong_AsUnsignedLong(item);
+            if (!PyErr_Occurred() && kind >= kind_count) {
+                PyErr_Format(PyExc_ValueError, "Invalid node kind id: %lu", kind);
+            } else if (!PyErr_Occurred()) {
+                kind_set[kind] = true;
+            }
+        }
+        Py_DECREF(item);
+        if (PyErr_Occurred()) {
+            break;
+        }
+    }
+    Py_DECREF(iterator);
+    if (PyErr_Occurred()) {
+        PyMem_RawFree(kind_set);
+        return NULL;
+    }
+    return kind_set;
+}
+
 PyDoc_STRVAR(language_subtypes_doc, "subtypes(self, supertype, /)\n--\n\n"
                                     "Get all subtype symbol IDs for a given supertype symbol.");
 PyDoc_STRVAR(language_node_kind_for_id_doc,
@@ -280,61 +517,61 @@ static PyMethodDef language_methods[] = {
     {
         .ml_name = "subtypes",
         .ml_meth = (PyCFunction)language_subtypes,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = language_subtypes_doc,
     },
     {
         .ml_name = "node_kind_for_id",
         .ml_meth = (PyCFunction)language_node_kind_for_id,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = language_node_kind_for_id_doc,
     },
     {
         .ml_name = "id_for_node_kind",
         .ml_meth = (PyCFunction)language_id_for_node_kind,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_FASTCALL,
         .ml_doc = language_id_for_node_kind_doc,
     },
     {
         .ml_name = "node_kind_is_named",
         .ml_meth = (PyCFunction)language_node_kind_is_named,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = language_node_kind_is_named_doc,
     },
     {
         .ml_name = "node_kind_is_visible",
         .ml_meth = (PyCFunction)language_node_kind_is_visible,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = language_node_kind_is_visible_doc,
     },
     {
         .ml_name = "node_kind_is_supertype",
         .ml_meth = (PyCFunction)language_node_kind_is_supertype,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = language_node_kind_is_supertype_doc,
     },
     {
         .ml_name = "field_name_for_id",
         .ml_meth = (PyCFunction)language_field_name_for_id,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = language_field_name_for_id_doc,
     },
     {
         .ml_name = "field_id_for_name",
         .ml_meth = (PyCFunction)language_field_id_for_name,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = language_field_id_for_name_doc,
     },
     {
         .ml_name = "next_state",
         .ml_meth = (PyCFunction)language_next_state,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_FASTCALL,
         .ml_doc = language_next_state_doc,
     },
     {
         .ml_name = "lookahead_iterator",
         .ml_meth = (PyCFunction)language_lookahead_iterator,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = language_lookahead_iterator_doc,
     },
     {
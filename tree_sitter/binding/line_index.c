@@ -0,0 +1,233 @@
+#include "types.h"
+
+#include <string.h>
+
+PyObject *point_new_internal(ModuleState *state, TSPoint point);
+PyObject *packed_array_new(ModuleState *state, const char *typecode, const void *data,
+                           size_t size);
+const Py_buffer *tree_get_source_view(Tree *self);
+
+void line_index_delete(LineIndex *index) {
+    if (index == NULL) {
+        return;
+    }
+    PyMem_Free(index->offsets);
+    PyMem_Free(index->is_ascii);
+    PyMem_Free(index);
+}
+
+static bool is_ascii(const char *text, uint32_t length) {
+    uint32_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, text + i, 8);
+        if (word & 0x8080808080808080ULL) {
+            return false;
+        }
+    }
+    for (; i < length; ++i) {
+        if ((uint8_t)text[i] & 0x80) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Record where every line starts and whether it is pure ASCII, in which case
+// its UTF-16 columns are the same as its byte columns.
+static LineIndex *line_index_get(Tree *tree, const char **text) {
+    const Py_buffer *view = tree_get_source_view(tree);
+    if (view == NULL) {
+        if (!PyErr_Occurred()) {
+            PyErr_SetString(PyExc_ValueError, "The tree has no source that can be read");
+        }
+        return NULL;
+    }
+    *text = view->buf;
+    if (tree->lines != NULL) {
+        return tree->lines;
+    }
+
+    const char *source = view->buf, *end = source + view->len, *newline;
+    uint32_t count = 1;
+    for (const char *line = source; (newline = memchr(line, '\n', end - line)) != NULL;
+         line = newline + 1) {
+        count++;
+    }
+    LineIndex *index = PyMem_Calloc(1, sizeof(LineIndex));
+    if (index == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    index->offsets = PyMem_Calloc(count + 1, sizeof(uint32_t));
+    index->is_ascii = PyMem_Calloc(count, sizeof(bool));
+    if (index->offsets == NULL || index->is_ascii == NULL) {
+        line_index_delete(index);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    index->count = count;
+    index->length = (uint32_t)view->len;
+
+    const char *line = source;
+    for (uint32_t row = 0; row < count; ++row) {
+        newline = memchr(line, '\n', end - line);
+        const char *line_end = newline != NULL ? newline + 1 : end;
+        index->offsets[row] = (uint32_t)(line - source);
+        index->is_ascii[row] = is_ascii(line, (uint32_t)(line_end - line));
+        line = line_end;
+    }
+    index->offsets[count] = index->length;
+    tree->lines = index;
+    return index;
+}
+
+// The number of bytes in a line, without its line break.
+static inline uint32_t line_length(const LineIndex *index, const char *text, uint32_t row) {
+    uint32_t start = index->offsets[row], end = index->offsets[row + 1];
+    return end > start && text[end - 1] == '\n' ? end - start - 1 : end - start;
+}
+
+static TSPoint to_utf16(const LineIndex *index, const char *text, TSPoint point) {
+    if (point.row >= index->count) {
+        point.row = index->count - 1;
+        point.column = UINT32_MAX;
+    }
+    uint32_t length = line_length(index, text, point.row);
+    uint32_t column = point.column < length ? point.column : length;
+    if (index->is_ascii[point.row]) {
+        return (TSPoint){point.row, column};
+    }
+
+    const uint8_t *line = (const uint8_t *)text + index->offsets[point.row];
+    uint32_t units = 0;
+    for (uint32_t i = 0; i < column; ++i) {
+        // continuation bytes add nothing, and four-byte sequences are surrogate pairs
+        units += (line[i] & 0xC0) != 0x80;
+        units += line[i] >= 0xF0;
+    }
+    return (TSPoint){point.row, units};
+}
+
+static TSPoint from_utf16(const LineIndex *index, const char *text, TSPoint point) {
+    if (point.row >= index->count) {
+        point.row = index->count - 1;
+        point.column = UINT32_MAX;
+    }
+    uint32_t length = line_length(index, text, point.row);
+    if (index->is_ascii[point.row]) {
+        return (TSPoint){point.row, point.column < length ? point.column : length};
+    }
+
+    const uint8_t *line = (const uint8_t *)text + index->offsets[point.row];
+    uint32_t i = 0;
+    for (uint32_t units = 0; i < length && units < point.column; ++i) {
+        if ((line[i] & 0xC0) != 0x80) {
+            units += line[i] >= 0xF0 ? 2 : 1;
+        }
+    }
+    while (i < length && (line[i] & 0xC0) == 0x80) {
+        i++;
+    }
+    return (TSPoint){point.row, i};
+}
+
+static uint32_t row_for_byte(const LineIndex *index, uint32_t byte) {
+    uint32_t low = 0, high = index->count;
+    while (high - low > 1) {
+        uint32_t mid = low + (high - low) / 2;
+        if (index->offsets[mid] <= byte) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+PyObject *tree_to_utf16_point(Tree *self, PyObject *arg) {
+    TSPoint point;
+    const char *text;
+    LineIndex *index = line_index_get(self, &text);
+    if (index == NULL) {
+        return NULL;
+    }
+    if (PyLong_Check(arg)) {
+        uint32_t byte;
+        if (!arg_as_uint32(arg, &byte)) {
+            return NULL;
+        }
+        byte = byte < index->length ? byte : index->length;
+        point.row = row_for_byte(index, byte);
+        point.column = byte - index->offsets[point.row];
+    } else if (!arg_as_point(arg, &point)) {
+        return NULL;
+    }
+    return point_new_internal(GET_MODULE_STATE(self), to_utf16(index, text, point));
+}
+
+PyObject *tree_from_utf16_point(Tree *self, PyObject *arg) {
+    TSPoint point;
+    const char *text;
+    LineIndex *index = line_index_get(self, &text);
+    if (index == NULL || !arg_as_point(arg, &point)) {
+        return NULL;
+    }
+    return point_new_internal(GET_MODULE_STATE(self), from_utf16(index, text, point));
+}
+
+// Accept unsigned 32-bit items in native byte order, as the points are copied as they are.
+static bool is_uint32_buffer(const Py_buffer *view) {
+    const char *format = view->format;
+    if (format == NULL || view->itemsize != sizeof(uint32_t)) {
+        return false;
+    }
+    if (*format == '@' || *format == '=') {
+        ++format;
+    }
+    return (format[0] == 'I' || format[0] == 'L') && format[1] == '\0';
+}
+
+static PyObject *convert_points(Tree *self, PyObject *arg, bool to_utf16_units) {
+    const char *text;
+    LineIndex *index = line_index_get(self, &text);
+    if (index == NULL) {
+        return NULL;
+    }
+    Py_buffer view;
+    if (PyObject_GetBuffer(arg, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0) {
+        return NULL;
+    }
+    if (!is_uint32_buffer(&view) || view.len % (2 * sizeof(uint32_t)) != 0) {
+        PyBuffer_Release(&view);
+        PyErr_SetString(PyExc_ValueError,
+                        "points must be a buffer of unsigned 32-bit row and column pairs");
+        return NULL;
+    }
+
+    size_t count = (size_t)view.len / sizeof(TSPoint);
+    TSPoint *points = PyMem_Malloc(count ? view.len : 1);
+    if (points == NULL) {
+        PyBuffer_Release(&view);
+        return PyErr_NoMemory();
+    }
+    memcpy(points, view.buf, view.len);
+    PyBuffer_Release(&view);
+
+    for (size_t i = 0; i < count; ++i) {
+        points[i] = to_utf16_units ? to_utf16(index, text, points[i])
+                                   : from_utf16(index, text, points[i]);
+    }
+    PyObject *result = packed_array_new(GET_MODULE_STATE(self), "I", points,
+                                        count * sizeof(TSPoint));
+    PyMem_Free(points);
+    return result;
+}
+
+PyObject *tree_to_utf16_points(Tree *self, PyObject *arg) {
+    return convert_points(self, arg, true);
+}
+
+PyObject *tree_from_utf16_points(Tree *self, PyObject *arg) {
+    return convert_points(self, arg, false);
+}
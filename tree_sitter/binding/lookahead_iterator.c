@@ -23,6 +23,10 @@ PyObject *lookahead_iterator_get_language(LookaheadIterator *self, void *Py_UNUS
         }
         language->language = language_id;
         language->abi_version = ts_language_abi_version(language->language);
+        language->kind_names = NULL;
+        language->field_names = NULL;
+        language->error_names = NULL;
+        language->kind_ids = language->field_ids = (NameTable){NULL, 0};
         self->language = PyObject_Init((PyObject *)language, state->language_type);
     }
     return Py_NewRef(self->language);
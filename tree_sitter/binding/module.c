@@ -1,7 +1,10 @@
 #include "types.h"
 
+extern PyType_Spec children_view_type_spec;
+extern PyType_Spec clone_index_type_spec;
 extern PyType_Spec language_type_spec;
 extern PyType_Spec lookahead_iterator_type_spec;
+extern PyType_Spec node_tracker_type_spec;
 extern PyType_Spec node_type_spec;
 extern PyType_Spec parser_type_spec;
 extern PyType_Spec point_type_spec;
@@ -16,6 +19,18 @@ extern PyType_Spec range_type_spec;
 extern PyType_Spec tree_cursor_type_spec;
 extern PyType_Spec tree_type_spec;
 
+extern PyMethodDef diff_methods[];
+
+PyObject *point_vectorcall(PyObject *type, PyObject *const *args, size_t nargsf,
+                           PyObject *kwnames);
+PyObject *range_vectorcall(PyObject *type, PyObject *const *args, size_t nargsf,
+                           PyObject *kwnames);
+
+void *allocator_malloc(size_t size);
+void *allocator_calloc(size_t count, size_t size);
+void *allocator_realloc(void *ptr, size_t size);
+void allocator_free(void *ptr);
+
 static inline PyObject *import_attribute(const char *mod, const char *attr) {
     PyObject *module = PyImport_ImportModule(mod);
     if (module == NULL) {
@@ -26,12 +41,64 @@ static inline PyObject *import_attribute(const char *mod, const char *attr) {
     return import;
 }
 
+PyObject *packed_array_new(ModuleState *state, const char *typecode, const void *data,
+                           size_t size) {
+    PyObject *array = PyObject_CallFunction(state->array_type, "s", typecode);
+    if (array == NULL || size == 0) {
+        return array;
+    }
+    PyObject *result = PyObject_CallMethod(array, "frombytes", "y#", data, (Py_ssize_t)size);
+    if (result == NULL) {
+        Py_DECREF(array);
+        return NULL;
+    }
+    Py_DECREF(result);
+    return array;
+}
+
+PyObject *vectorcall_fallback(PyObject *callable, PyObject *const *args, Py_ssize_t nargs,
+                              PyObject *kwnames) {
+    PyObject *tuple = PyTuple_New(nargs);
+    if (tuple == NULL) {
+        return NULL;
+    }
+    for (Py_ssize_t i = 0; i < nargs; ++i) {
+        PyTuple_SET_ITEM(tuple, i, Py_NewRef(args[i]));
+    }
+
+    PyObject *kwargs = NULL;
+    if (kwnames != NULL) {
+        if ((kwargs = PyDict_New()) == NULL) {
+            Py_DECREF(tuple);
+            return NULL;
+        }
+        for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(kwnames); ++i) {
+            if (PyDict_SetItem(kwargs, PyTuple_GET_ITEM(kwnames, i), args[nargs + i]) < 0) {
+                Py_DECREF(tuple);
+                Py_DECREF(kwargs);
+                return NULL;
+            }
+        }
+    }
+
+    PyObject *result = PyType_Type.tp_call(callable, tuple, kwargs);
+    Py_DECREF(tuple);
+    Py_XDECREF(kwargs);
+    return result;
+}
+
 static void module_free(void *self) {
     ModuleState *state = PyModule_GetState((PyObject *)self);
     ts_tree_cursor_delete(&state->default_cursor);
+    for (uint32_t i = 0; i < state->node_freelist_size; ++i) {
+        PyObject_Free(state->node_freelist[i]);
+    }
+    Py_XDECREF(state->children_view_type);
+    Py_XDECREF(state->clone_index_type);
     Py_XDECREF(state->language_type);
     Py_XDECREF(state->log_type_type);
     Py_XDECREF(state->lookahead_iterator_type);
+    Py_XDECREF(state->node_tracker_type);
     Py_XDECREF(state->node_type);
     Py_XDECREF(state->parser_type);
     Py_XDECREF(state->point_type);
@@ -45,7 +112,9 @@ static void module_free(void *self) {
     Py_XDECREF(state->tree_cursor_type);
     Py_XDECREF(state->tree_type);
     Py_XDECREF(state->query_error);
+    Py_XDECREF(state->memory_limit_exceeded);
     Py_XDECREF(state->re_compile);
+    Py_XDECREF(state->array_type);
 }
 
 static struct PyModuleDef module_definition = {
@@ -64,13 +133,19 @@ PyMODINIT_FUNC PyInit__binding(void) {
 
     ModuleState *state = PyModule_GetState(module);
 
-    ts_set_allocator(PyMem_Malloc, PyMem_Calloc, PyMem_Realloc, PyMem_Free);
+    ts_set_allocator(allocator_malloc, allocator_calloc, allocator_realloc, allocator_free);
 
+    state->children_view_type =
+        (PyTypeObject *)PyType_FromModuleAndSpec(module, &children_view_type_spec, NULL);
+    state->clone_index_type =
+        (PyTypeObject *)PyType_FromModuleAndSpec(module, &clone_index_type_spec, NULL);
     state->language_type =
         (PyTypeObject *)PyType_FromModuleAndSpec(module, &language_type_spec, NULL);
     state->lookahead_iterator_type =
         (PyTypeObject *)PyType_FromModuleAndSpec(module, &lookahead_iterator_type_spec, NULL);
     state->node_type = (PyTypeObject *)PyType_FromModuleAndSpec(module, &node_type_spec, NULL);
+    state->node_tracker_type =
+        (PyTypeObject *)PyType_FromModuleAndSpec(module, &node_tracker_type_spec, NULL);
     state->parser_type = (PyTypeObject *)PyType_FromModuleAndSpec(module, &parser_type_spec, NULL);
     state->point_type = (PyTypeObject *)PyType_FromModuleAndSpec(module, &point_type_spec,
                                                                  (PyObject *)&PyTuple_Type);
@@ -92,10 +167,20 @@ PyMODINIT_FUNC PyInit__binding(void) {
         (PyTypeObject *)PyType_FromModuleAndSpec(module, &tree_cursor_type_spec, NULL);
     state->tree_type = (PyTypeObject *)PyType_FromModuleAndSpec(module, &tree_type_spec, NULL);
 
-    if ((PyModule_AddObjectRef(module, "Language", (PyObject *)state->language_type) < 0) ||
+    // Py_tp_vectorcall is only available as a type slot since 3.14.
+    if (state->point_type != NULL && state->range_type != NULL) {
+        state->point_type->tp_vectorcall = point_vectorcall;
+        state->range_type->tp_vectorcall = range_vectorcall;
+    }
+
+    if ((PyModule_AddObjectRef(module, "ChildrenView",
+                               (PyObject *)state->children_view_type) < 0) ||
+        (PyModule_AddObjectRef(module, "CloneIndex", (PyObject *)state->clone_index_type) < 0) ||
+        (PyModule_AddObjectRef(module, "Language", (PyObject *)state->language_type) < 0) ||
         (PyModule_AddObjectRef(module, "LookaheadIterator",
                                (PyObject *)state->lookahead_iterator_type) < 0) ||
         (PyModule_AddObjectRef(module, "Node", (PyObject *)state->node_type) < 0) ||
+        (PyModule_AddObjectRef(module, "NodeTracker", (PyObject *)state->node_tracker_type) < 0) ||
         (PyModule_AddObjectRef(module, "Parser", (PyObject *)state->parser_type) < 0) ||
         (PyModule_AddObjectRef(module, "Point", (PyObject *)state->point_type) < 0) ||
         (PyModule_AddObjectRef(module, "Query", (PyObject *)state->query_type) < 0) ||
@@ -125,11 +210,29 @@ PyMODINIT_FUNC PyInit__binding(void) {
         goto cleanup;
     }
 
+    state->memory_limit_exceeded = PyErr_NewExceptionWithDoc(
+        "tree_sitter.MemoryLimitExceeded",
+        PyDoc_STR("An error that occurred when a parse exceeded its memory limit."),
+        PyExc_MemoryError, NULL);
+    if (state->memory_limit_exceeded == NULL ||
+        PyModule_AddObjectRef(module, "MemoryLimitExceeded", state->memory_limit_exceeded) < 0) {
+        goto cleanup;
+    }
+
     state->re_compile = import_attribute("re", "compile");
     if (state->re_compile == NULL) {
         goto cleanup;
     }
 
+    state->array_type = import_attribute("array", "array");
+    if (state->array_type == NULL) {
+        goto cleanup;
+    }
+
+    if (PyModule_AddFunctions(module, diff_methods) < 0) {
+        goto cleanup;
+    }
+
     PyObject *int_enum = import_attribute("enum", "IntEnum");
     if (int_enum == NULL) {
         goto cleanup;
@@ -138,9 +241,19 @@ PyMODINIT_FUNC PyInit__binding(void) {
         int_enum, "s{sisi}", "LogType", "PARSE", TSLogTypeParse, "LEX", TSLogTypeLex);
     if (state->log_type_type == NULL ||
         PyModule_AddObjectRef(module, "LogType", (PyObject *)state->log_type_type) < 0) {
+        Py_DECREF(int_enum);
         goto cleanup;
     };
+
+    PyObject *diff_operation = PyObject_CallFunction(int_enum, "s{sisisisi}", "DiffOperation",
+                                                     "INSERT", 0, "DELETE", 1, "UPDATE", 2,
+                                                     "MOVE", 3);
     Py_DECREF(int_enum);
+    if (diff_operation == NULL ||
+        PyModule_AddObject(module, "DiffOperation", diff_operation) < 0) {
+        Py_XDECREF(diff_operation);
+        goto cleanup;
+    }
 
     PyModule_AddIntConstant(module, "LANGUAGE_VERSION", TREE_SITTER_LANGUAGE_VERSION);
     PyModule_AddIntConstant(module, "MIN_COMPATIBLE_LANGUAGE_VERSION",
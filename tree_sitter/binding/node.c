@@ -1,21 +1,67 @@
 #include "types.h"
 
 PyObject *point_new_internal(ModuleState *state, TSPoint point);
+const Py_buffer *tree_get_source_view(Tree *self);
+PyObject *children_view_new(ModuleState *state, Node *node, ChildrenView *all);
+Py_ssize_t tree_char_offset(Tree *self, const Py_buffer *view, uint32_t byte);
+Py_ssize_t tree_read_source(Tree *self, uint32_t start_byte, TSPoint start_point,
+                            uint32_t end_byte, char *buffer);
+void allocator_free(void *ptr);
+uint32_t tree_index_find(const TreeIndex *index, TSNode node);
+bool tree_index_parent(const TreeIndex *index, TSNode node, TSNode *result);
+bool tree_index_next_sibling(const TreeIndex *index, TSNode node, TSNode *result);
+bool tree_index_prev_sibling(const TreeIndex *index, TSNode node, TSNode *result);
+bool *language_kind_set_new(Language *self, PyObject *kinds);
+PyObject *packed_array_new(ModuleState *state, const char *typecode, const void *data,
+                           size_t size);
+PyObject *language_kind_name(Language *self, TSSymbol symbol);
+PyObject *language_field_name(Language *self, TSFieldId field_id);
+PyObject *language_field_name_for_string(Language *self, const char *field_name);
+TSFieldId language_field_id(Language *self, const char *name, uint32_t length);
+Node *node_table_get(const NodeTable *table, TSNode node);
+bool node_table_insert(NodeTable *table, Node *node);
+void node_table_remove(NodeTable *table, Node *node);
 
 PyObject *node_new_internal(ModuleState *state, TSNode node, PyObject *tree) {
-    Node *self = PyObject_New(Node, state->node_type);
+    NodeTable *nodes = ((Tree *)tree)->nodes;
+    if (nodes != NULL) {
+        Node *interned = node_table_get(nodes, node);
+        if (interned != NULL) {
+            return Py_NewRef(interned);
+        }
+    }
+
+    Node *self = state->node_freelist_size > 0
+                     ? (Node *)state->node_freelist[--state->node_freelist_size]
+                     : PyObject_New(Node, state->node_type);
     if (self == NULL) {
         return NULL;
     }
     self->node = node;
     self->tree = Py_NewRef(tree);
     self->children = NULL;
-    return PyObject_Init((PyObject *)self, state->node_type);
+    PyObject_Init((PyObject *)self, state->node_type);
+    // a node that could not be interned is still a valid node
+    if (nodes != NULL && !ts_node_is_null(node)) {
+        node_table_insert(nodes, self);
+    }
+    return (PyObject *)self;
 }
 
 void node_dealloc(Node *self) {
+    NodeTable *nodes = self->tree != NULL ? ((Tree *)self->tree)->nodes : NULL;
+    if (nodes != NULL) {
+        node_table_remove(nodes, self);
+    }
     Py_XDECREF(self->children);
     Py_XDECREF(self->tree);
+
+    // Nodes are created and discarded at a high rate, so keep some around for reuse.
+    ModuleState *state = GET_MODULE_STATE(self);
+    if (state->node_freelist_size < NODE_FREELIST_SIZE) {
+        state->node_freelist[state->node_freelist_size++] = (PyObject *)self;
+        return;
+    }
     Py_TYPE(self)->tp_free(self);
 }
 
@@ -34,7 +80,7 @@ PyObject *node_repr(Node *self) {
 PyObject *node_str(Node *self) {
     char *string = ts_node_string(self->node);
     PyObject *result = PyUnicode_FromString(string);
-    PyMem_Free(string);
+    allocator_free(string);
     return result;
 }
 
@@ -85,15 +131,20 @@ PyObject *node_edit(Node *self, PyObject *args, PyObject *kwargs) {
         .new_end_point = {new_end_row, new_end_column},
     };
 
+    // The table is keyed by the start byte, so an edited node leaves it for good.
+    NodeTable *nodes = ((Tree *)self->tree)->nodes;
+    if (nodes != NULL) {
+        node_table_remove(nodes, self);
+    }
     ts_node_edit(&self->node, &edit);
 
     Py_RETURN_NONE;
 }
 
-PyObject *node_child(Node *self, PyObject *args) {
+PyObject *node_child(Node *self, PyObject *arg) {
     ModuleState *state = GET_MODULE_STATE(self);
     long index;
-    if (!PyArg_ParseTuple(args, "l:child", &index)) {
+    if (!arg_as_long(arg, &index)) {
         return NULL;
     }
     if (index < 0) {
@@ -110,10 +161,10 @@ PyObject *node_child(Node *self, PyObject *args) {
     return node_new_internal(state, child, self->tree);
 }
 
-PyObject *node_named_child(Node *self, PyObject *args) {
+PyObject *node_named_child(Node *self, PyObject *arg) {
     ModuleState *state = GET_MODULE_STATE(self);
     long index;
-    if (!PyArg_ParseTuple(args, "l:named_child", &index)) {
+    if (!arg_as_long(arg, &index)) {
         return NULL;
     }
     if (index < 0) {
@@ -129,30 +180,30 @@ PyObject *node_named_child(Node *self, PyObject *args) {
     return node_new_internal(state, child, self->tree);
 }
 
-PyObject *node_first_child_for_byte(Node *self, PyObject *args) {
+PyObject *node_first_child_for_byte(Node *self, PyObject *arg) {
     ModuleState *state = GET_MODULE_STATE(self);
     uint32_t byte;
-    if (!PyArg_ParseTuple(args, "I:first_child_for_byte", &byte)) {
+    if (!arg_as_uint32(arg, &byte)) {
         return NULL;
     }
     TSNode child = ts_node_first_child_for_byte(self->node, byte);
     return node_new_internal(state, child, self->tree);
 }
 
-PyObject *node_first_named_child_for_byte(Node *self, PyObject *args) {
+PyObject *node_first_named_child_for_byte(Node *self, PyObject *arg) {
     ModuleState *state = GET_MODULE_STATE(self);
     uint32_t byte;
-    if (!PyArg_ParseTuple(args, "I:first_named_child_for_byte", &byte)) {
+    if (!arg_as_uint32(arg, &byte)) {
         return NULL;
     }
     TSNode child = ts_node_first_named_child_for_byte(self->node, byte);
     return node_new_internal(state, child, self->tree);
 }
 
-PyObject *node_child_by_field_id(Node *self, PyObject *args) {
+PyObject *node_child_by_field_id(Node *self, PyObject *arg) {
     ModuleState *state = GET_MODULE_STATE(self);
     TSFieldId field_id;
-    if (!PyArg_ParseTuple(args, "H:child_by_field_id", &field_id)) {
+    if (!arg_as_uint16(arg, &field_id)) {
         return NULL;
     }
 
@@ -163,15 +214,20 @@ PyObject *node_child_by_field_id(Node *self, PyObject *args) {
     return node_new_internal(state, child, self->tree);
 }
 
-PyObject *node_child_by_field_name(Node *self, PyObject *args) {
+PyObject *node_child_by_field_name(Node *self, PyObject *arg) {
     ModuleState *state = GET_MODULE_STATE(self);
-    char *name;
     Py_ssize_t length;
-    if (!PyArg_ParseTuple(args, "s#:child_by_field_name", &name, &length)) {
+    const char *name = arg_as_utf8(arg, &length);
+    if (name == NULL) {
         return NULL;
     }
 
-    TSNode child = ts_node_child_by_field_name(self->node, name, length);
+    Language *language = (Language *)((Tree *)self->tree)->language;
+    TSFieldId field_id = language_field_id(language, name, (uint32_t)length);
+    if (field_id == 0) {
+        Py_RETURN_NONE;
+    }
+    TSNode child = ts_node_child_by_field_id(self->node, field_id);
     if (ts_node_is_null(child)) {
         Py_RETURN_NONE;
     }
@@ -201,30 +257,77 @@ static PyObject *node_children_by_field_id_internal(Node *self, TSFieldId field_
     return result;
 }
 
-PyObject *node_children_by_field_id(Node *self, PyObject *args) {
+PyObject *node_children_by_field_id(Node *self, PyObject *arg) {
     TSFieldId field_id;
-    if (!PyArg_ParseTuple(args, "H:child_by_field_id", &field_id)) {
+    if (!arg_as_uint16(arg, &field_id)) {
         return NULL;
     }
 
     return node_children_by_field_id_internal(self, field_id);
 }
 
-PyObject *node_children_by_field_name(Node *self, PyObject *args) {
-    char *name;
+PyObject *node_children_by_field_name(Node *self, PyObject *arg) {
     Py_ssize_t length;
-    if (!PyArg_ParseTuple(args, "s#:child_by_field_name", &name, &length)) {
+    const char *name = arg_as_utf8(arg, &length);
+    if (name == NULL) {
         return NULL;
     }
 
-    const TSLanguage *lang = ts_tree_language(((Tree *)self->tree)->tree);
-    TSFieldId field_id = ts_language_field_id_for_name(lang, name, length);
+    Language *language = (Language *)((Tree *)self->tree)->language;
+    TSFieldId field_id = language_field_id(language, name, (uint32_t)length);
     return node_children_by_field_id_internal(self, field_id);
 }
 
-PyObject *node_field_name_for_child(Node *self, PyObject *args) {
+PyObject *node_fields(Node *self, PyObject *Py_UNUSED(args)) {
+    ModuleState *state = GET_MODULE_STATE(self);
+    Language *language = (Language *)((Tree *)self->tree)->language;
+    PyObject *result = PyDict_New();
+    if (result == NULL) {
+        return NULL;
+    }
+
+    TSTreeCursor *cursor = &state->default_cursor;
+    ts_tree_cursor_reset(cursor, self->node);
+    for (bool ok = ts_tree_cursor_goto_first_child(cursor); ok;
+         ok = ts_tree_cursor_goto_next_sibling(cursor)) {
+        TSFieldId field_id = ts_tree_cursor_current_field_id(cursor);
+        if (field_id == 0) {
+            continue;
+        }
+        // The field names are interned, so each lookup only compares pointers.
+        PyObject *name = language_field_name(language, field_id);
+        if (name == NULL) {
+            goto error;
+        }
+        PyObject *children = PyDict_GetItemWithError(result, name);
+        if (children == NULL) {
+            children = PyErr_Occurred() ? NULL : PyList_New(0);
+            if (children == NULL || PyDict_SetItem(result, name, children) < 0) {
+                Py_XDECREF(children);
+                Py_DECREF(name);
+                goto error;
+            }
+            Py_DECREF(children);
+        }
+        Py_DECREF(name);
+
+        PyObject *node = node_new_internal(state, ts_tree_cursor_current_node(cursor), self->tree);
+        if (node == NULL || PyList_Append(children, node) < 0) {
+            Py_XDECREF(node);
+            goto error;
+        }
+        Py_DECREF(node);
+    }
+    return result;
+
+error:
+    Py_DECREF(result);
+    return NULL;
+}
+
+PyObject *node_field_name_for_child(Node *self, PyObject *arg) {
     long index;
-    if (!PyArg_ParseTuple(args, "l:field_name_for_child", &index)) {
+    if (!arg_as_long(arg, &index)) {
         return NULL;
     }
     if (index < 0) {
@@ -236,16 +339,14 @@ PyObject *node_field_name_for_child(Node *self, PyObject *args) {
         return NULL;
     }
 
-    const char *field_name = ts_node_field_name_for_child(self->node, index);
-    if (field_name == NULL) {
-        Py_RETURN_NONE;
-    }
-    return PyUnicode_FromString(field_name);
+    Language *language = (Language *)((Tree *)self->tree)->language;
+    return language_field_name_for_string(language,
+                                          ts_node_field_name_for_child(self->node, index));
 }
 
-PyObject *node_field_name_for_named_child(Node *self, PyObject *args) {
+PyObject *node_field_name_for_named_child(Node *self, PyObject *arg) {
     long index;
-    if (!PyArg_ParseTuple(args, "l:field_name_for_named_child", &index)) {
+    if (!arg_as_long(arg, &index)) {
         return NULL;
     }
     if (index < 0) {
@@ -257,17 +358,16 @@ PyObject *node_field_name_for_named_child(Node *self, PyObject *args) {
         return NULL;
     }
 
-    const char *field_name = ts_node_field_name_for_named_child(self->node, index);
-    if (field_name == NULL) {
-        Py_RETURN_NONE;
-    }
-    return PyUnicode_FromString(field_name);
+    Language *language = (Language *)((Tree *)self->tree)->language;
+    return language_field_name_for_string(language,
+                                          ts_node_field_name_for_named_child(self->node, index));
 }
 
-PyObject *node_descendant_for_byte_range(Node *self, PyObject *args) {
+PyObject *node_descendant_for_byte_range(Node *self, PyObject *const *args, Py_ssize_t nargs) {
     ModuleState *state = GET_MODULE_STATE(self);
     uint32_t start_byte, end_byte;
-    if (!PyArg_ParseTuple(args, "II:descendant_for_byte_range", &start_byte, &end_byte)) {
+    if (!check_arg_count("descendant_for_byte_range", nargs, 2) ||
+        !arg_as_uint32(args[0], &start_byte) || !arg_as_uint32(args[1], &end_byte)) {
         return NULL;
     }
     TSNode descendant = ts_node_descendant_for_byte_range(self->node, start_byte, end_byte);
@@ -277,10 +377,12 @@ PyObject *node_descendant_for_byte_range(Node *self, PyObject *args) {
     return node_new_internal(state, descendant, self->tree);
 }
 
-PyObject *node_named_descendant_for_byte_range(Node *self, PyObject *args) {
+PyObject *node_named_descendant_for_byte_range(Node *self, PyObject *const *args,
+                                              Py_ssize_t nargs) {
     ModuleState *state = GET_MODULE_STATE(self);
     uint32_t start_byte, end_byte;
-    if (!PyArg_ParseTuple(args, "II:named_descendant_for_byte_range", &start_byte, &end_byte)) {
+    if (!check_arg_count("named_descendant_for_byte_range", nargs, 2) ||
+        !arg_as_uint32(args[0], &start_byte) || !arg_as_uint32(args[1], &end_byte)) {
         return NULL;
     }
     TSNode descendant = ts_node_named_descendant_for_byte_range(self->node, start_byte, end_byte);
@@ -290,11 +392,12 @@ PyObject *node_named_descendant_for_byte_range(Node *self, PyObject *args) {
     return node_new_internal(state, descendant, self->tree);
 }
 
-PyObject *node_descendant_for_point_range(Node *self, PyObject *args) {
+PyObject *node_descendant_for_point_range(Node *self, PyObject *const *args,
+                                         Py_ssize_t nargs) {
     ModuleState *state = GET_MODULE_STATE(self);
     TSPoint start, end;
-    if (!PyArg_ParseTuple(args, "(II)(II):descendant_for_point_range", &start.row, &start.column,
-                          &end.row, &end.column)) {
+    if (!check_arg_count("descendant_for_point_range", nargs, 2) ||
+        !arg_as_point(args[0], &start) || !arg_as_point(args[1], &end)) {
         return NULL;
     }
 
@@ -305,11 +408,12 @@ PyObject *node_descendant_for_point_range(Node *self, PyObject *args) {
     return node_new_internal(state, descendant, self->tree);
 }
 
-PyObject *node_named_descendant_for_point_range(Node *self, PyObject *args) {
+PyObject *node_named_descendant_for_point_range(Node *self, PyObject *const *args,
+                                               Py_ssize_t nargs) {
     ModuleState *state = GET_MODULE_STATE(self);
     TSPoint start, end;
-    if (!PyArg_ParseTuple(args, "(II)(II):descendant_for_point_range", &start.row, &start.column,
-                          &end.row, &end.column)) {
+    if (!check_arg_count("named_descendant_for_point_range", nargs, 2) ||
+        !arg_as_point(args[0], &start) || !arg_as_point(args[1], &end)) {
         return NULL;
     }
 
@@ -320,10 +424,11 @@ PyObject *node_named_descendant_for_point_range(Node *self, PyObject *args) {
     return node_new_internal(state, descendant, self->tree);
 }
 
-PyObject *node_child_with_descendant(Node *self, PyObject *args) {
+PyObject *node_child_with_descendant(Node *self, PyObject *descendant) {
     ModuleState *state = GET_MODULE_STATE(self);
-    PyObject *descendant;
-    if (!PyArg_ParseTuple(args, "O!:child_with_descendant", state->node_type, &descendant)) {
+    if (!PyObject_TypeCheck(descendant, state->node_type)) {
+        PyErr_Format(PyExc_TypeError, "child_with_descendant() argument must be %s, not %s",
+                     state->node_type->tp_name, Py_TYPE(descendant)->tp_name);
         return NULL;
     }
 
@@ -334,6 +439,124 @@ PyObject *node_child_with_descendant(Node *self, PyObject *args) {
     return node_new_internal(state, child, self->tree);
 }
 
+static bool push_ancestor(TSNode **ancestors, uint32_t *count, uint32_t *capacity, TSNode node) {
+    if (*count == *capacity) {
+        uint32_t new_capacity = *capacity ? *capacity * 2 : 16;
+        TSNode *resized = PyMem_Realloc(*ancestors, new_capacity * sizeof(TSNode));
+        if (resized == NULL) {
+            return false;
+        }
+        *ancestors = resized;
+        *capacity = new_capacity;
+    }
+    (*ancestors)[(*count)++] = node;
+    return true;
+}
+
+// Collect the ancestors of a node, nearest first. Without a parent index, this descends
+// from the root node once, whereas every call to ts_node_parent descends from the root again.
+static bool collect_ancestors(Node *self, TSNode **ancestors, uint32_t *count) {
+    uint32_t capacity = 0;
+    TreeIndex *index = ((Tree *)self->tree)->index;
+    uint32_t i = index != NULL ? tree_index_find(index, self->node) : UINT32_MAX;
+    if (i != UINT32_MAX) {
+        while ((i = index->parents[i]) != UINT32_MAX) {
+            if (!push_ancestor(ancestors, count, &capacity, index->nodes[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    TSNode ancestor = ts_tree_root_node(self->node.tree);
+    while (!ts_node_is_null(ancestor) && ancestor.id != self->node.id) {
+        if (!push_ancestor(ancestors, count, &capacity, ancestor)) {
+            return false;
+        }
+        ancestor = ts_node_child_with_descendant(ancestor, self->node);
+    }
+    for (uint32_t j = 0; j < *count / 2; ++j) {
+        TSNode node = (*ancestors)[j];
+        (*ancestors)[j] = (*ancestors)[*count - 1 - j];
+        (*ancestors)[*count - 1 - j] = node;
+    }
+    return true;
+}
+
+#define ANCESTOR_FIELDS 3
+
+PyObject *node_ancestors(Node *self, PyObject *args, PyObject *kwargs) {
+    ModuleState *state = GET_MODULE_STATE(self);
+    PyObject *kinds_obj = Py_None, *until_obj = Py_None;
+    int packed = 0;
+    char *keywords[] = {"kinds", "until", "packed", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OO$p:ancestors", keywords, &kinds_obj,
+                                     &until_obj, &packed)) {
+        return NULL;
+    }
+
+    Language *language = (Language *)((Tree *)self->tree)->language;
+    uint32_t kind_count = ts_language_symbol_count(language->language);
+    bool *kinds = NULL, *until = NULL;
+    if (kinds_obj != Py_None && (kinds = language_kind_set_new(language, kinds_obj)) == NULL) {
+        return NULL;
+    }
+    if (until_obj != Py_None && (until = language_kind_set_new(language, until_obj)) == NULL) {
+        PyMem_RawFree(kinds);
+        return NULL;
+    }
+
+    PyObject *result = NULL;
+    TSNode *ancestors = NULL;
+    uint32_t count = 0, kept = 0;
+    if (!collect_ancestors(self, &ancestors, &count)) {
+        PyErr_NoMemory();
+        goto cleanup;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        TSSymbol symbol = ts_node_symbol(ancestors[i]);
+        if (kinds == NULL || (symbol < kind_count && kinds[symbol])) {
+            ancestors[kept++] = ancestors[i];
+        }
+        if (until != NULL && symbol < kind_count && until[symbol]) {
+            break;
+        }
+    }
+
+    if (packed) {
+        uint32_t *items = PyMem_Malloc((kept ? kept : 1) * ANCESTOR_FIELDS * sizeof(uint32_t));
+        if (items == NULL) {
+            PyErr_NoMemory();
+            goto cleanup;
+        }
+        for (uint32_t i = 0; i < kept; ++i) {
+            uint32_t *item = items + i * ANCESTOR_FIELDS;
+            item[0] = ts_node_symbol(ancestors[i]);
+            item[1] = ts_node_start_byte(ancestors[i]);
+            item[2] = ts_node_end_byte(ancestors[i]);
+        }
+        result = packed_array_new(state, "I", items, kept * ANCESTOR_FIELDS * sizeof(uint32_t));
+        PyMem_Free(items);
+        goto cleanup;
+    }
+
+    result = PyList_New(kept);
+    for (uint32_t i = 0; result != NULL && i < kept; ++i) {
+        PyObject *node = node_new_internal(state, ancestors[i], self->tree);
+        if (node == NULL) {
+            Py_CLEAR(result);
+            break;
+        }
+        PyList_SET_ITEM(result, i, node);
+    }
+
+cleanup:
+    PyMem_Free(ancestors);
+    PyMem_RawFree(kinds);
+    PyMem_RawFree(until);
+    return result;
+}
+
 PyObject *node_get_id(Node *self, void *Py_UNUSED(payload)) {
     return PyLong_FromVoidPtr((void *)self->node.id);
 }
@@ -347,11 +570,13 @@ PyObject *node_get_grammar_id(Node *self, void *Py_UNUSED(payload)) {
 }
 
 PyObject *node_get_type(Node *self, void *Py_UNUSED(payload)) {
-    return PyUnicode_FromString(ts_node_type(self->node));
+    Language *language = (Language *)((Tree *)self->tree)->language;
+    return language_kind_name(language, ts_node_symbol(self->node));
 }
 
 PyObject *node_get_grammar_name(Node *self, void *Py_UNUSED(payload)) {
-    return PyUnicode_FromString(ts_node_grammar_type(self->node));
+    Language *language = (Language *)((Tree *)self->tree)->language;
+    return language_kind_name(language, ts_node_grammar_symbol(self->node));
 }
 
 PyObject *node_get_is_named(Node *self, void *Py_UNUSED(payload)) {
@@ -438,31 +663,10 @@ PyObject *node_get_end_point(Node *self, void *Py_UNUSED(payload)) {
 }
 
 PyObject *node_get_children(Node *self, void *Py_UNUSED(payload)) {
-    ModuleState *state = GET_MODULE_STATE(self);
-    if (self->children) {
-        return Py_NewRef(self->children);
-    }
-
-    uint32_t length = ts_node_child_count(self->node);
-    PyObject *result = PyList_New(length);
-    if (result == NULL) {
-        return NULL;
-    }
-    if (length > 0) {
-        ts_tree_cursor_reset(&state->default_cursor, self->node);
-        ts_tree_cursor_goto_first_child(&state->default_cursor);
-        uint32_t i = 0;
-        do {
-            TSNode child = ts_tree_cursor_current_node(&state->default_cursor);
-            PyObject *node = node_new_internal(state, child, self->tree);
-            if (PyList_SetItem(result, i++, node) < 0) {
-                Py_DECREF(result);
-                return NULL;
-            }
-        } while (ts_tree_cursor_goto_next_sibling(&state->default_cursor));
+    if (self->children == NULL) {
+        self->children = children_view_new(GET_MODULE_STATE(self), self, NULL);
     }
-    self->children = Py_NewRef(result);
-    return self->children;
+    return Py_XNewRef(self->children);
 }
 
 PyObject *node_get_named_children(Node *self, void *payload) {
@@ -470,25 +674,9 @@ PyObject *node_get_named_children(Node *self, void *payload) {
     if (children == NULL) {
         return NULL;
     }
-    // children is retained by self->children
+    PyObject *result =
+        children_view_new(GET_MODULE_STATE(self), self, (ChildrenView *)children);
     Py_DECREF(children);
-
-    uint32_t named_count = ts_node_named_child_count(self->node);
-    PyObject *result = PyList_New(named_count);
-    if (result == NULL) {
-        return NULL;
-    }
-
-    uint32_t length = ts_node_child_count(self->node);
-    for (uint32_t i = 0, j = 0; i < length; ++i) {
-        PyObject *child = PyList_GetItem(self->children, i);
-        if (ts_node_is_named(((Node *)child)->node)) {
-            if (PyList_SetItem(result, j++, Py_NewRef(child)) < 0) {
-                Py_DECREF(result);
-                return NULL;
-            }
-        }
-    }
     return result;
 }
 
@@ -502,7 +690,11 @@ PyObject *node_get_named_child_count(Node *self, void *Py_UNUSED(payload)) {
 
 PyObject *node_get_parent(Node *self, void *Py_UNUSED(payload)) {
     ModuleState *state = GET_MODULE_STATE(self);
-    TSNode parent = ts_node_parent(self->node);
+    TreeIndex *index = ((Tree *)self->tree)->index;
+    TSNode parent;
+    if (index == NULL || !tree_index_parent(index, self->node, &parent)) {
+        parent = ts_node_parent(self->node);
+    }
     if (ts_node_is_null(parent)) {
         Py_RETURN_NONE;
     }
@@ -511,7 +703,11 @@ PyObject *node_get_parent(Node *self, void *Py_UNUSED(payload)) {
 
 PyObject *node_get_next_sibling(Node *self, void *Py_UNUSED(payload)) {
     ModuleState *state = PyType_GetModuleState(Py_TYPE(self));
-    TSNode next_sibling = ts_node_next_sibling(self->node);
+    TreeIndex *index = ((Tree *)self->tree)->index;
+    TSNode next_sibling;
+    if (index == NULL || !tree_index_next_sibling(index, self->node, &next_sibling)) {
+        next_sibling = ts_node_next_sibling(self->node);
+    }
     if (ts_node_is_null(next_sibling)) {
         Py_RETURN_NONE;
     }
@@ -520,7 +716,11 @@ PyObject *node_get_next_sibling(Node *self, void *Py_UNUSED(payload)) {
 
 PyObject *node_get_prev_sibling(Node *self, void *Py_UNUSED(payload)) {
     ModuleState *state = PyType_GetModuleState(Py_TYPE(self));
-    TSNode prev_sibling = ts_node_prev_sibling(self->node);
+    TreeIndex *index = ((Tree *)self->tree)->index;
+    TSNode prev_sibling;
+    if (index == NULL || !tree_index_prev_sibling(index, self->node, &prev_sibling)) {
+        prev_sibling = ts_node_prev_sibling(self->node);
+    }
     if (ts_node_is_null(prev_sibling)) {
         Py_RETURN_NONE;
     }
@@ -549,6 +749,19 @@ PyObject *node_get_descendant_count(Node *self, void *Py_UNUSED(payload)) {
     return PyLong_FromUnsignedLong(ts_node_descendant_count(self->node));
 }
 
+PyObject *node_get_structural_hash(Node *self, void *Py_UNUSED(payload)) {
+    TreeIndex *index = ((Tree *)self->tree)->index;
+    if (index == NULL || index->hashes == NULL) {
+        Py_RETURN_NONE;
+    }
+    uint32_t i = tree_index_find(index, self->node);
+    if (i == UINT32_MAX) {
+        PyErr_SetString(PyExc_ValueError, "Node is not part of its tree");
+        return NULL;
+    }
+    return PyLong_FromUnsignedLongLong(index->hashes[i]);
+}
+
 PyObject *node_get_text(Node *self, void *Py_UNUSED(payload)) {
     Tree *tree = (Tree *)self->tree;
     if (tree == NULL) {
@@ -559,118 +772,98 @@ PyObject *node_get_text(Node *self, void *Py_UNUSED(payload)) {
         Py_RETURN_NONE;
     }
 
-    PyObject *result = NULL;
     uint32_t start_offset = ts_node_start_byte(self->node),
              end_offset = ts_node_end_byte(self->node);
+    const Py_buffer *view = tree_get_source_view(tree);
+    if (view != NULL) {
+        uint32_t length = (uint32_t)view->len;
+        end_offset = end_offset < length ? end_offset : length;
+        start_offset = start_offset < end_offset ? start_offset : end_offset;
+        return PyBytes_FromStringAndSize((const char *)view->buf + start_offset,
+                                         end_offset - start_offset);
+    }
+    if (PyErr_Occurred()) {
+        return NULL;
+    }
 
-    // Case 1: source is a byte buffer
-    if (!PyCallable_Check(tree->source)) {
-        PyObject *start_byte = PyLong_FromUnsignedLong(start_offset),
-                 *end_byte = PyLong_FromUnsignedLong(end_offset);
-        PyObject *slice = PySlice_New(start_byte, end_byte, NULL);
-        Py_XDECREF(start_byte);
-        Py_XDECREF(end_byte);
-        if (slice == NULL) {
-            return NULL;
-        }
-
-        PyObject *node_mv = PyMemoryView_FromObject(tree->source);
-        if (node_mv == NULL) {
-            Py_DECREF(slice);
-            return NULL;
-        }
+    // The source is a read callback that is too large to cache, so read only this node.
+    PyObject *result = PyBytes_FromStringAndSize(NULL, end_offset - start_offset);
+    if (result == NULL) {
+        return NULL;
+    }
+    Py_ssize_t length = tree_read_source(tree, start_offset, ts_node_start_point(self->node),
+                                         end_offset, PyBytes_AS_STRING(result));
+    if (length < 0) {
+        Py_DECREF(result);
+        return NULL;
+    }
+    if (length < (Py_ssize_t)(end_offset - start_offset)) {
+        Py_SETREF(result, PyBytes_FromStringAndSize(PyBytes_AS_STRING(result), length));
+    }
+    return result;
+}
 
-        PyObject *node_slice = PyObject_GetItem(node_mv, slice);
-        Py_DECREF(slice);
-        Py_DECREF(node_mv);
-        if (node_slice == NULL) {
+PyObject *node_get_text_view(Node *self, void *Py_UNUSED(payload)) {
+    Tree *tree = (Tree *)self->tree;
+    if (tree->source == Py_None || tree->source == NULL) {
+        Py_RETURN_NONE;
+    }
+    const Py_buffer *view = tree_get_source_view(tree);
+    if (view == NULL) {
+        if (PyErr_Occurred()) {
             return NULL;
         }
-
-        result = PyBytes_FromObject(node_slice);
-        Py_DECREF(node_slice);
-    } else {
-        // Case 2: source is a callable
-        PyObject *collected_bytes = PyByteArray_FromStringAndSize(NULL, 0);
-        if (collected_bytes == NULL) {
+        PyObject *text = node_get_text(self, NULL);
+        if (text == NULL) {
             return NULL;
         }
-        TSPoint start_point = ts_node_start_point(self->node);
-        TSPoint current_point = start_point;
-
-        for (size_t current_offset = start_offset; current_offset < end_offset;) {
-            PyObject *byte_offset_obj = PyLong_FromSize_t(current_offset);
-            if (!byte_offset_obj) {
-                Py_DECREF(collected_bytes);
-                return NULL;
-            }
-            PyObject *position_obj = point_new_internal(GET_MODULE_STATE(self), current_point);
-            if (!position_obj) {
-                Py_DECREF(byte_offset_obj);
-                Py_DECREF(collected_bytes);
-                return NULL;
-            }
-
-            PyObject *args = PyTuple_Pack(2, byte_offset_obj, position_obj);
-            Py_XDECREF(byte_offset_obj);
-            Py_XDECREF(position_obj);
-
-            PyObject *rv = PyObject_Call(tree->source, args, NULL);
-            Py_XDECREF(args);
-
-            PyObject *rv_bytearray = PyByteArray_FromObject(rv);
-            if (rv_bytearray == NULL) {
-                Py_DECREF(collected_bytes);
-                Py_XDECREF(rv);
-                return NULL;
-            }
-
-            Py_ssize_t bytes_read = PyByteArray_Size(rv_bytearray);
-            char *rv_str = PyByteArray_AsString(rv_bytearray);
-            if (bytes_read < 0 || rv_str == NULL) {
-                Py_DECREF(rv_bytearray);
-                Py_DECREF(collected_bytes);
-                Py_XDECREF(rv);
-                return NULL;
-            }
+        PyObject *result = PyMemoryView_FromObject(text);
+        Py_DECREF(text);
+        return result;
+    }
+    Py_ssize_t end_offset = Py_MIN((Py_ssize_t)ts_node_end_byte(self->node), view->len),
+               start_offset = Py_MIN((Py_ssize_t)ts_node_start_byte(self->node), end_offset);
+    PyObject *source_view = PyMemoryView_FromObject(view->obj);
+    if (source_view == NULL) {
+        return NULL;
+    }
+    PyObject *result = PySequence_GetSlice(source_view, start_offset, end_offset);
+    Py_DECREF(source_view);
+    return result;
+}
 
-            PyObject *new_collected_bytes = PyByteArray_Concat(collected_bytes, rv_bytearray);
-            Py_DECREF(rv_bytearray);
-            Py_DECREF(collected_bytes);
-            if (new_collected_bytes == NULL) {
-                Py_XDECREF(rv);
-                return NULL;
-            }
-            collected_bytes = new_collected_bytes;
-
-            Py_XDECREF(rv);
-            for (Py_ssize_t i = 0; i < bytes_read; ++i) {
-                if (rv_str[i] == '\n') {
-                    ++current_point.row;
-                    current_point.column = 0;
-                } else {
-                    ++current_point.column;
-                }
-            }
-            current_offset += (size_t)bytes_read;
-        }
+PyObject *node_get_text_str(Node *self, void *Py_UNUSED(payload)) {
+    PyObject *text = node_get_text(self, NULL);
+    if (text == NULL || text == Py_None) {
+        return text;
+    }
+    PyObject *result = PyUnicode_DecodeUTF8(PyBytes_AS_STRING(text), PyBytes_GET_SIZE(text), NULL);
+    Py_DECREF(text);
+    return result;
+}
 
-        PyObject *start_byte = PyLong_FromSize_t(0);
-        PyObject *end_byte = PyLong_FromSize_t(end_offset - start_offset);
-        PyObject *slice = PySlice_New(start_byte, end_byte, NULL);
-        Py_XDECREF(start_byte);
-        Py_XDECREF(end_byte);
-        if (slice == NULL) {
-            Py_DECREF(collected_bytes);
+static PyObject *node_char_offset(Node *self, uint32_t byte) {
+    Tree *tree = (Tree *)self->tree;
+    if (tree->source == Py_None || tree->source == NULL) {
+        Py_RETURN_NONE;
+    }
+    const Py_buffer *view = tree_get_source_view(tree);
+    if (view == NULL) {
+        if (PyErr_Occurred()) {
             return NULL;
         }
-        result = PyObject_GetItem(collected_bytes, slice);
-        Py_DECREF(slice);
-        Py_DECREF(collected_bytes);
+        Py_RETURN_NONE;
     }
-    PyObject *bytes_result = PyBytes_FromObject(result);
-    Py_DECREF(result);
-    return bytes_result;
+    Py_ssize_t offset = tree_char_offset(tree, view, byte);
+    return offset < 0 ? NULL : PyLong_FromSsize_t(offset);
+}
+
+PyObject *node_get_start_char(Node *self, void *Py_UNUSED(payload)) {
+    return node_char_offset(self, ts_node_start_byte(self->node));
+}
+
+PyObject *node_get_end_char(Node *self, void *Py_UNUSED(payload)) {
+    return node_char_offset(self, ts_node_end_byte(self->node));
 }
 
 Py_hash_t node_hash(Node *self) {
@@ -681,6 +874,24 @@ Py_hash_t node_hash(Node *self) {
     return id == tree ? id : id ^ tree;
 }
 
+PyDoc_STRVAR(
+    node_ancestors_doc,
+    "ancestors(self, /, kinds=None, until=None, *, packed=False)\n--\n\n"
+    "Get the ancestors of this node, starting with its parent, in a single call." DOC_PARAMETERS
+    "kinds\n\n   The kind names or ids of the ancestors to include.\n"
+    "until\n\n   The kind names or ids at which to stop. The nearest ancestor of one of these "
+    "kinds is the last one that is considered.\n"
+    "packed\n\n   Whether to return the ancestors as an array instead of nodes." DOC_RETURNS
+    "A list of nodes or, if ``packed`` is true, an :class:`array.array` with three items per "
+    "ancestor: the kind id, the start byte and the end byte." DOC_NOTE
+    "If the tree has a parent index, it is used to find the ancestors. Otherwise, they are found "
+    "by descending from the root node once." DOC_SEE_ALSO ":meth:`Tree.build_parent_index`");
+PyDoc_STRVAR(node_fields_doc,
+             "fields(self, /)\n--\n\n"
+             "Get the children of this node that have a field name, grouped by field.\n\n"
+             "Unlike repeated calls to :meth:`children_by_field_name`, this visits the children "
+             "only once." DOC_RETURNS "A dictionary that maps each field name to the list of "
+             "children with that field, in the order in which the fields first appear.");
 PyDoc_STRVAR(node_walk_doc, "walk(self, /)\n--\n\n"
                             "Create a new :class:`TreeCursor` starting from this node.");
 PyDoc_STRVAR(node_edit_doc,
@@ -745,6 +956,12 @@ PyDoc_STRVAR(node_child_with_descendant_doc, "child_with_descendant(self, descen
                                              "Get the node that contains the given descendant.");
 
 static PyMethodDef node_methods[] = {
+    {
+        .ml_name = "ancestors",
+        .ml_meth = (PyCFunction)node_ancestors,
+        .ml_flags = METH_VARARGS | METH_KEYWORDS,
+        .ml_doc = node_ancestors_doc,
+    },
     {
         .ml_name = "walk",
         .ml_meth = (PyCFunction)node_walk,
@@ -760,91 +977,97 @@ static PyMethodDef node_methods[] = {
     {
         .ml_name = "child",
         .ml_meth = (PyCFunction)node_child,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = node_child_doc,
     },
     {
         .ml_name = "named_child",
         .ml_meth = (PyCFunction)node_named_child,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = node_named_child_doc,
     },
     {
         .ml_name = "first_child_for_byte",
         .ml_meth = (PyCFunction)node_first_child_for_byte,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = node_first_child_for_byte_doc,
     },
     {
         .ml_name = "first_named_child_for_byte",
         .ml_meth = (PyCFunction)node_first_named_child_for_byte,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = node_first_named_child_for_byte_doc,
     },
     {
         .ml_name = "child_by_field_id",
         .ml_meth = (PyCFunction)node_child_by_field_id,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = node_child_by_field_id_doc,
     },
     {
         .ml_name = "child_by_field_name",
         .ml_meth = (PyCFunction)node_child_by_field_name,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = node_child_by_field_name_doc,
     },
     {
         .ml_name = "children_by_field_id",
         .ml_meth = (PyCFunction)node_children_by_field_id,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = node_children_by_field_id_doc,
     },
     {
         .ml_name = "children_by_field_name",
         .ml_meth = (PyCFunction)node_children_by_field_name,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = node_children_by_field_name_doc,
     },
+    {
+        .ml_name = "fields",
+        .ml_meth = (PyCFunction)node_fields,
+        .ml_flags = METH_NOARGS,
+        .ml_doc = node_fields_doc,
+    },
     {
         .ml_name = "field_name_for_child",
         .ml_meth = (PyCFunction)node_field_name_for_child,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = node_field_name_for_child_doc,
     },
     {
         .ml_name = "field_name_for_named_child",
         .ml_meth = (PyCFunction)node_field_name_for_named_child,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = node_field_name_for_named_child_doc,
     },
     {
         .ml_name = "descendant_for_byte_range",
         .ml_meth = (PyCFunction)node_descendant_for_byte_range,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_FASTCALL,
         .ml_doc = node_descendant_for_byte_range_doc,
     },
     {
         .ml_name = "named_descendant_for_byte_range",
         .ml_meth = (PyCFunction)node_named_descendant_for_byte_range,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_FASTCALL,
         .ml_doc = node_named_descendant_for_byte_range_doc,
     },
     {
         .ml_name = "descendant_for_point_range",
         .ml_meth = (PyCFunction)node_descendant_for_point_range,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_FASTCALL,
         .ml_doc = node_descendant_for_point_range_doc,
     },
     {
         .ml_name = "named_descendant_for_point_range",
         .ml_meth = (PyCFunction)node_named_descendant_for_point_range,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_FASTCALL,
         .ml_doc = node_named_descendant_for_point_range_doc,
     },
     {
         .ml_name = "child_with_descendant",
         .ml_meth = (PyCFunction)node_child_with_descendant,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = node_child_with_descendant_doc,
     },
     {NULL},
@@ -903,7 +1126,8 @@ static PyGetSetDef node_accessors[] = {
     {"start_point", (getter)node_get_start_point, NULL, PyDoc_STR("This node's start point"), NULL},
     {"end_point", (getter)node_get_end_point, NULL, PyDoc_STR("This node's end point."), NULL},
     {"children", (getter)node_get_children, NULL,
-     PyDoc_STR("This node's children." DOC_NOTE
+     PyDoc_STR("This node's children, as a read-only sequence that creates the child nodes "
+               "when they are accessed." DOC_NOTE
                "If you're walking the tree recursively, you may want to use :meth:`walk` instead."),
      NULL},
     {"child_count", (getter)node_get_child_count, NULL,
@@ -925,6 +1149,26 @@ static PyGetSetDef node_accessors[] = {
      PyDoc_STR("This node's number of descendants, including the node itself."), NULL},
     {"text", (getter)node_get_text, NULL,
      PyDoc_STR("The text of the node, if the tree has not been edited"), NULL},
+    {"text_str", (getter)node_get_text_str, NULL,
+     PyDoc_STR("The text of the node decoded from UTF-8, if the tree has not been edited."),
+     NULL},
+    {"start_char", (getter)node_get_start_char, NULL,
+     PyDoc_STR("The code point offset where the node starts in the decoded source, "
+               "if the tree has not been edited."),
+     NULL},
+    {"end_char", (getter)node_get_end_char, NULL,
+     PyDoc_STR("The code point offset where the node ends in the decoded source, "
+               "if the tree has not been edited."),
+     NULL},
+    {"text_view", (getter)node_get_text_view, NULL,
+     PyDoc_STR("A :class:`memoryview` of the text of the node, if the tree has not been "
+               "edited." DOC_NOTE "The view shares memory with the source of the tree if it is "
+               ":class:`bytes`, or else with a copy of the source taken on first use."),
+     NULL},
+    {"structural_hash", (getter)node_get_structural_hash, NULL,
+     PyDoc_STR("The structural hash of the node, if :meth:`Tree.compute_hashes` has been "
+               "called since the tree was last edited."),
+     NULL},
     {NULL},
 };
 
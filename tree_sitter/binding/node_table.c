@@ -0,0 +1,118 @@
+#include "types.h"
+
+#include <string.h>
+
+static inline uint32_t slot_hash(const void *id, uint32_t start_byte) {
+    uint64_t key = ((uint64_t)(uintptr_t)id >> 3) ^ ((uint64_t)start_byte << 32);
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+static inline bool slot_matches(const NodeTableSlot *slot, TSNode node) {
+    return slot->id == node.id && slot->start_byte == ts_node_start_byte(node);
+}
+
+NodeTable *node_table_new(void) {
+    NodeTable *table = PyMem_Calloc(1, sizeof(NodeTable));
+    if (table == NULL) {
+        return NULL;
+    }
+    table->slots = PyMem_Calloc(64, sizeof(NodeTableSlot));
+    if (table->slots == NULL) {
+        PyMem_Free(table);
+        return NULL;
+    }
+    table->mask = 63;
+    return table;
+}
+
+void node_table_delete(NodeTable *table) {
+    if (table == NULL) {
+        return;
+    }
+    PyMem_Free(table->slots);
+    PyMem_Free(table);
+}
+
+void node_table_clear(NodeTable *table) {
+    if (table == NULL) {
+        return;
+    }
+    memset(table->slots, 0, ((size_t)table->mask + 1) * sizeof(NodeTableSlot));
+    table->size = 0;
+}
+
+Node *node_table_get(const NodeTable *table, TSNode node) {
+    uint32_t slot = slot_hash(node.id, ts_node_start_byte(node)) & table->mask;
+    while (table->slots[slot].node != NULL) {
+        if (slot_matches(&table->slots[slot], node)) {
+            return table->slots[slot].node;
+        }
+        slot = (slot + 1) & table->mask;
+    }
+    return NULL;
+}
+
+static void node_table_put(NodeTable *table, NodeTableSlot entry) {
+    uint32_t slot = slot_hash(entry.id, entry.start_byte) & table->mask;
+    while (table->slots[slot].node != NULL) {
+        slot = (slot + 1) & table->mask;
+    }
+    table->slots[slot] = entry;
+    table->size++;
+}
+
+bool node_table_insert(NodeTable *table, Node *node) {
+    // keep the load factor below one half
+    if ((table->size + 1) * 2 > table->mask + 1) {
+        uint32_t capacity = (table->mask + 1) * 2;
+        NodeTableSlot *slots = PyMem_Calloc(capacity, sizeof(NodeTableSlot));
+        if (slots == NULL) {
+            return false;
+        }
+        NodeTableSlot *old_slots = table->slots;
+        uint32_t old_capacity = table->mask + 1;
+        table->slots = slots;
+        table->mask = capacity - 1;
+        table->size = 0;
+        for (uint32_t i = 0; i < old_capacity; ++i) {
+            if (old_slots[i].node != NULL) {
+                node_table_put(table, old_slots[i]);
+            }
+        }
+        PyMem_Free(old_slots);
+    }
+    NodeTableSlot entry = {
+        .id = node->node.id,
+        .start_byte = ts_node_start_byte(node->node),
+        .node = node,
+    };
+    node_table_put(table, entry);
+    return true;
+}
+
+void node_table_remove(NodeTable *table, Node *node) {
+    uint32_t slot = slot_hash(node->node.id, ts_node_start_byte(node->node)) & table->mask;
+    while (table->slots[slot].node != node) {
+        if (table->slots[slot].node == NULL) {
+            return;
+        }
+        slot = (slot + 1) & table->mask;
+    }
+
+    // Shift the following entries back so that lookups never stop at the hole.
+    uint32_t hole = slot;
+    for (;;) {
+        slot = (slot + 1) & table->mask;
+        NodeTableSlot *entry = &table->slots[slot];
+        if (entry->node == NULL) {
+            break;
+        }
+        uint32_t home = slot_hash(entry->id, entry->start_byte) & table->mask;
+        if (((slot - home) & table->mask) >= ((slot - hole) & table->mask)) {
+            table->slots[hole] = *entry;
+            hole = slot;
+        }
+    }
+    table->slots[hole] = (NodeTableSlot){0};
+    table->size--;
+}
@@ -0,0 +1,505 @@
+#include "types.h"
+
+#include <string.h>
+
+#define NONE UINT32_MAX
+#define TOMBSTONE ((const void *)(uintptr_t)1)
+
+void allocator_free(void *ptr);
+
+// The id of a node is the address of its slot in the child array of its parent. Reused
+// subtrees keep their child arrays across reparses, so only their roots move to another
+// slot. The kind is part of the key in case a slot is reused for another node.
+static inline uint32_t key_hash(const void *key) {
+    uint64_t value = (uint64_t)(uintptr_t)key >> 3;
+    return (uint32_t)((value * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+static TrackedNode *tracker_lookup(NodeTracker *self, TSNode node) {
+    if (self->capacity == 0) {
+        return NULL;
+    }
+    TSSymbol symbol = ts_node_symbol(node);
+    uint32_t mask = self->capacity - 1;
+    for (uint32_t slot = key_hash(node.id) & mask;; slot = (slot + 1) & mask) {
+        TrackedNode *entry = &self->nodes[slot];
+        if (entry->key == node.id && entry->symbol == symbol) {
+            return entry;
+        }
+        if (entry->key == NULL) {
+            return NULL;
+        }
+    }
+}
+
+static bool tracker_grow(NodeTracker *self) {
+    uint32_t capacity = self->capacity ? self->capacity : 64;
+    while (capacity / 2 <= self->size + 1) {
+        capacity *= 2;
+    }
+    TrackedNode *nodes = PyMem_Calloc(capacity, sizeof(TrackedNode));
+    if (nodes == NULL) {
+        return false;
+    }
+
+    uint32_t mask = capacity - 1;
+    for (uint32_t i = 0; i < self->capacity; ++i) {
+        TrackedNode *entry = &self->nodes[i];
+        if (entry->key == NULL || entry->key == TOMBSTONE) {
+            continue;
+        }
+        uint32_t slot = key_hash(entry->key) & mask;
+        while (nodes[slot].key != NULL) {
+            slot = (slot + 1) & mask;
+        }
+        nodes[slot] = *entry;
+    }
+
+    PyMem_Free(self->nodes);
+    self->nodes = nodes;
+    self->capacity = capacity;
+    self->used = self->size;
+    return true;
+}
+
+static bool tracker_insert(NodeTracker *self, TSNode node, uint64_t id) {
+    if ((self->used + 1) * 2 > self->capacity && !tracker_grow(self)) {
+        return false;
+    }
+    uint32_t mask = self->capacity - 1;
+    uint32_t slot = key_hash(node.id) & mask;
+    while (self->nodes[slot].key != NULL && self->nodes[slot].key != TOMBSTONE) {
+        slot = (slot + 1) & mask;
+    }
+    if (self->nodes[slot].key == NULL) {
+        self->used += 1;
+    }
+    self->nodes[slot] = (TrackedNode){
+        .key = node.id,
+        .id = id,
+        .generation = self->generation,
+        .symbol = ts_node_symbol(node),
+    };
+    self->size += 1;
+    return true;
+}
+
+static inline void tracker_remove(NodeTracker *self, TrackedNode *entry) {
+    entry->key = TOMBSTONE;
+    self->size -= 1;
+}
+
+static void tracker_clear(NodeTracker *self) {
+    PyMem_Free(self->nodes);
+    self->nodes = NULL;
+    self->capacity = self->size = self->used = 0;
+}
+
+static bool tracker_track_all(NodeTracker *self, const TSTree *tree) {
+    TSTreeCursor cursor = ts_tree_cursor_new(ts_tree_root_node(tree));
+    bool ok = true;
+    for (;;) {
+        TSNode node = ts_tree_cursor_current_node(&cursor);
+        if (!(ok = tracker_insert(self, node, self->next_id++))) {
+            break;
+        }
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            continue;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                goto done;
+            }
+        }
+    }
+done:
+    ts_tree_cursor_delete(&cursor);
+    return ok;
+}
+
+static bool is_changed(const TSRange *ranges, uint32_t count, TSNode node) {
+    uint32_t start = ts_node_start_byte(node), end = ts_node_end_byte(node);
+    uint32_t low = 0, high = count;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (ranges[mid].end_byte < start) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low < count && ranges[low].start_byte <= end;
+}
+
+typedef struct {
+    TSNode node;
+    uint32_t parent;
+    uint64_t id;
+} PendingNode;
+
+// A node of the old tree that was not reused, whose id can go to the new node replacing it.
+typedef struct {
+    uint64_t id;
+    uint64_t parent_id;
+    uint32_t start;
+    uint32_t end;
+    uint32_t next_by_range;
+    uint32_t next_by_parent;
+    TSSymbol symbol;
+    bool claimed;
+} Candidate;
+
+static inline uint32_t range_hash(uint32_t start, uint32_t end, TSSymbol symbol) {
+    uint64_t hash = hash_combine(hash_combine(HASH_SEED, start), end);
+    return (uint32_t)hash_finish(hash_combine(hash, symbol));
+}
+
+static inline uint32_t parent_hash(uint32_t start, TSSymbol symbol, uint64_t parent_id) {
+    uint64_t hash = hash_combine(hash_combine(HASH_SEED, start), symbol);
+    return (uint32_t)hash_finish(hash_combine(hash, parent_id));
+}
+
+// Find the candidate that a new node replaces: one with the same kind and range, or,
+// inside of the changed ranges, one with the same kind, start and parent.
+static Candidate *match_candidate(Candidate *candidates, const uint32_t *range_buckets,
+                                  const uint32_t *parent_buckets, uint32_t mask, TSNode node,
+                                  uint64_t parent_id, bool changed) {
+    uint32_t start = ts_node_start_byte(node), end = ts_node_end_byte(node);
+    TSSymbol symbol = ts_node_symbol(node);
+    for (uint32_t i = range_buckets[range_hash(start, end, symbol) & mask]; i != NONE;
+         i = candidates[i].next_by_range) {
+        Candidate *candidate = &candidates[i];
+        if (!candidate->claimed && candidate->start == start && candidate->end == end &&
+            candidate->symbol == symbol) {
+            return candidate;
+        }
+    }
+    if (!changed || parent_id == UINT64_MAX) {
+        return NULL;
+    }
+
+    for (uint32_t i = parent_buckets[parent_hash(start, symbol, parent_id) & mask]; i != NONE;
+         i = candidates[i].next_by_parent) {
+        Candidate *candidate = &candidates[i];
+        if (!candidate->claimed && candidate->start == start && candidate->symbol == symbol &&
+            candidate->parent_id == parent_id) {
+            return candidate;
+        }
+    }
+    return NULL;
+}
+
+// Chain the candidates by their range and by their parent, in two tables of the same size.
+// They are in preorder, so each chain lists the deepest ones first.
+static uint32_t *index_candidates(Candidate *candidates, uint32_t count, uint32_t *mask) {
+    uint32_t capacity = 16;
+    while (capacity < count * 2) {
+        capacity *= 2;
+    }
+    uint32_t *buckets = PyMem_Malloc(2 * capacity * sizeof(uint32_t));
+    if (buckets == NULL) {
+        return NULL;
+    }
+    memset(buckets, 0xFF, 2 * capacity * sizeof(uint32_t));
+
+    *mask = capacity - 1;
+    uint32_t *range_buckets = buckets, *parent_buckets = buckets + capacity;
+    for (uint32_t i = 0; i < count; ++i) {
+        Candidate *candidate = &candidates[i];
+        uint32_t bucket = range_hash(candidate->start, candidate->end, candidate->symbol) & *mask;
+        candidate->next_by_range = range_buckets[bucket];
+        range_buckets[bucket] = i;
+        bucket = parent_hash(candidate->start, candidate->symbol, candidate->parent_id) & *mask;
+        candidate->next_by_parent = parent_buckets[bucket];
+        parent_buckets[bucket] = i;
+    }
+    return buckets;
+}
+
+static bool reserve(void **array, uint32_t *capacity, uint32_t count, size_t item_size) {
+    if (count < *capacity) {
+        return true;
+    }
+    uint32_t new_capacity = *capacity ? *capacity * 2 : 64;
+    void *new_array = PyMem_Realloc(*array, new_capacity * item_size);
+    if (new_array == NULL) {
+        return false;
+    }
+    *array = new_array;
+    *capacity = new_capacity;
+    return true;
+}
+
+bool node_tracker_advance(NodeTracker *self, Tree *old_tree, Tree *new_tree) {
+    self->generation += 1;
+    uint32_t range_count;
+    TSRange *ranges = ts_tree_get_changed_ranges(old_tree->tree, new_tree->tree, &range_count);
+    PendingNode *pending = NULL;
+    Candidate *candidates = NULL;
+    uint32_t *parents = NULL, *buckets = NULL;
+    uint64_t *parent_ids = NULL;
+    uint32_t pending_count = 0, pending_capacity = 0, parents_capacity = 0;
+    uint32_t candidate_count = 0, candidate_capacity = 0, parent_ids_capacity = 0, mask = 0;
+    bool ok = true;
+
+    // Mark the reused subtrees, which are already known, and collect the new nodes.
+    TSTreeCursor cursor = ts_tree_cursor_new(ts_tree_root_node(new_tree->tree));
+    for (;;) {
+        TSNode node = ts_tree_cursor_current_node(&cursor);
+        TrackedNode *entry = tracker_lookup(self, node);
+        if (entry != NULL) {
+            entry->generation = self->generation;
+        } else {
+            uint32_t depth = ts_tree_cursor_current_depth(&cursor);
+            if (!reserve((void **)&pending, &pending_capacity, pending_count,
+                         sizeof(PendingNode)) ||
+                !reserve((void **)&parents, &parents_capacity, depth, sizeof(uint32_t))) {
+                ok = false;
+                goto done;
+            }
+            pending[pending_count] = (PendingNode){
+                .node = node,
+                .parent = depth > 0 ? parents[depth - 1] : UINT32_MAX,
+            };
+            parents[depth] = pending_count++;
+            if (ts_tree_cursor_goto_first_child(&cursor)) {
+                continue;
+            }
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                goto forget;
+            }
+        }
+    }
+
+forget:
+    // Forget the nodes of the old tree that were not reused, but keep their ids around.
+    ts_tree_cursor_reset(&cursor, ts_tree_root_node(old_tree->tree));
+    for (;;) {
+        TSNode node = ts_tree_cursor_current_node(&cursor);
+        TrackedNode *entry = tracker_lookup(self, node);
+        if (entry == NULL || entry->generation != self->generation) {
+            uint32_t depth = ts_tree_cursor_current_depth(&cursor);
+            if (!reserve((void **)&candidates, &candidate_capacity, candidate_count,
+                         sizeof(Candidate)) ||
+                !reserve((void **)&parent_ids, &parent_ids_capacity, depth, sizeof(uint64_t))) {
+                ok = false;
+                goto done;
+            }
+            parent_ids[depth] = entry != NULL ? entry->id : UINT64_MAX;
+            if (entry != NULL) {
+                candidates[candidate_count++] = (Candidate){
+                    .id = entry->id,
+                    .parent_id = depth > 0 ? parent_ids[depth - 1] : UINT64_MAX,
+                    .start = ts_node_start_byte(node),
+                    .end = ts_node_end_byte(node),
+                    .symbol = entry->symbol,
+                    .claimed = false,
+                };
+                tracker_remove(self, entry);
+            }
+            if (ts_tree_cursor_goto_first_child(&cursor)) {
+                continue;
+            }
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                goto match;
+            }
+        }
+    }
+
+match:
+    if ((buckets = index_candidates(candidates, candidate_count, &mask)) == NULL) {
+        ok = false;
+        goto done;
+    }
+
+    // Give the new nodes the ids of the old nodes that they replace.
+    for (uint32_t i = 0; i < pending_count; ++i) {
+        PendingNode *node = &pending[i];
+        uint64_t parent_id = node->parent != UINT32_MAX ? pending[node->parent].id : UINT64_MAX;
+        bool changed = is_changed(ranges, range_count, node->node);
+        Candidate *candidate = match_candidate(candidates, buckets, buckets + mask + 1, mask,
+                                               node->node, parent_id, changed);
+        if (candidate != NULL) {
+            candidate->claimed = true;
+            node->id = candidate->id;
+        } else {
+            node->id = self->next_id++;
+        }
+        if (!(ok = tracker_insert(self, node->node, node->id))) {
+            goto done;
+        }
+    }
+
+done:
+    ts_tree_cursor_delete(&cursor);
+    PyMem_Free(pending);
+    PyMem_Free(parents);
+    PyMem_Free(candidates);
+    PyMem_Free(parent_ids);
+    PyMem_Free(buckets);
+    allocator_free(ranges);
+    if (!ok) {
+        PyErr_NoMemory();
+        tracker_clear(self);
+        self->tree = NULL;
+        return false;
+    }
+    self->tree = new_tree;
+    return true;
+}
+
+// Editing a tree copies the subtrees that contain the edit if they are shared.
+// Walk the changed nodes of the tree before and after the edit to move their ids.
+bool node_tracker_rekey(NodeTracker *self, const TSTree *old_tree, const TSTree *new_tree) {
+    TSTreeCursor old_cursor = ts_tree_cursor_new(ts_tree_root_node(old_tree));
+    TSTreeCursor new_cursor = ts_tree_cursor_new(ts_tree_root_node(new_tree));
+    bool ok = true;
+    for (;;) {
+        TSNode old_node = ts_tree_cursor_current_node(&old_cursor);
+        TSNode new_node = ts_tree_cursor_current_node(&new_cursor);
+        TrackedNode *entry;
+        if (old_node.id != new_node.id && (entry = tracker_lookup(self, old_node)) != NULL) {
+            uint64_t id = entry->id;
+            tracker_remove(self, entry);
+            if (!(ok = tracker_insert(self, new_node, id))) {
+                break;
+            }
+        }
+        if (ts_node_has_changes(new_node) && ts_tree_cursor_goto_first_child(&new_cursor)) {
+            ts_tree_cursor_goto_first_child(&old_cursor);
+            continue;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&new_cursor)) {
+            if (!ts_tree_cursor_goto_parent(&new_cursor)) {
+                goto done;
+            }
+            ts_tree_cursor_goto_parent(&old_cursor);
+        }
+        ts_tree_cursor_goto_next_sibling(&old_cursor);
+    }
+
+done:
+    ts_tree_cursor_delete(&old_cursor);
+    ts_tree_cursor_delete(&new_cursor);
+    if (!ok) {
+        PyErr_NoMemory();
+        tracker_clear(self);
+        self->tree = NULL;
+    }
+    return ok;
+}
+
+void node_tracker_detach(NodeTracker *self, Tree *tree) {
+    if (self->tree == tree) {
+        tracker_clear(self);
+        self->tree = NULL;
+    }
+}
+
+void node_tracker_dealloc(NodeTracker *self) {
+    PyMem_Free(self->nodes);
+    Py_TYPE(self)->tp_free(self);
+}
+
+PyObject *node_tracker_new(PyTypeObject *cls, PyObject *Py_UNUSED(args),
+                           PyObject *Py_UNUSED(kwargs)) {
+    NodeTracker *self = (NodeTracker *)cls->tp_alloc(cls, 0);
+    if (self != NULL) {
+        self->tree = NULL;
+        self->nodes = NULL;
+        self->capacity = self->size = self->used = 0;
+        self->generation = 1;
+        self->next_id = 0;
+    }
+    return (PyObject *)self;
+}
+
+int node_tracker_init(NodeTracker *self, PyObject *args, PyObject *kwargs) {
+    ModuleState *state = GET_MODULE_STATE(self);
+    Tree *tree;
+    char *keywords[] = {"tree", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!:__init__", keywords, state->tree_type,
+                                     &tree)) {
+        return -1;
+    }
+    if (self->tree != NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "The tracker is already initialized");
+        return -1;
+    }
+    if (tree->tracker != NULL && tree->tracker->tree == tree) {
+        PyErr_SetString(PyExc_ValueError, "The tree is already tracked");
+        return -1;
+    }
+
+    if (!tracker_track_all(self, tree->tree)) {
+        tracker_clear(self);
+        PyErr_NoMemory();
+        return -1;
+    }
+    self->tree = tree;
+    Py_XSETREF(tree->tracker, (NodeTracker *)Py_NewRef(self));
+    return 0;
+}
+
+PyObject *node_tracker_get_tree(NodeTracker *self, void *Py_UNUSED(payload)) {
+    if (self->tree == NULL) {
+        Py_RETURN_NONE;
+    }
+    return Py_NewRef(self->tree);
+}
+
+Py_ssize_t node_tracker_length(NodeTracker *self) { return self->size; }
+
+PyObject *node_tracker_subscript(NodeTracker *self, PyObject *arg) {
+    if (!IS_INSTANCE(arg, node_type)) {
+        PyErr_Format(PyExc_TypeError, "NodeTracker indices must be Node, not %s",
+                     arg->ob_type->tp_name);
+        return NULL;
+    }
+
+    Node *node = (Node *)arg;
+    TrackedNode *entry = NULL;
+    if (self->tree != NULL && node->node.tree == self->tree->tree) {
+        entry = tracker_lookup(self, node->node);
+    }
+    if (entry == NULL) {
+        PyErr_SetObject(PyExc_KeyError, arg);
+        return NULL;
+    }
+    return PyLong_FromUnsignedLongLong(entry->id);
+}
+
+static PyGetSetDef node_tracker_accessors[] = {
+    {"tree", (getter)node_tracker_get_tree, NULL,
+     PyDoc_STR("The tree whose nodes are currently tracked, if any."), NULL},
+    {NULL},
+};
+
+static PyType_Slot node_tracker_type_slots[] = {
+    {Py_tp_doc,
+     PyDoc_STR("A class that assigns stable ids to the nodes of a :class:`Tree`.\n\n"
+               "The ids are carried over to the new tree whenever the tracked tree is passed "
+               "to :meth:`Parser.parse` as the old tree. Nodes in reused subtrees keep their "
+               "ids, and only the new nodes are matched against the nodes that they replace, "
+               "so the cost of an update is proportional to the size of the edit." DOC_TIP
+               "Use ``tracker[node]`` to get the id of a node of the tracked tree.")},
+    {Py_tp_new, node_tracker_new},
+    {Py_tp_init, node_tracker_init},
+    {Py_tp_dealloc, node_tracker_dealloc},
+    {Py_tp_getset, node_tracker_accessors},
+    {Py_mp_length, node_tracker_length},
+    {Py_mp_subscript, node_tracker_subscript},
+    {0, NULL},
+};
+
+PyType_Spec node_tracker_type_spec = {
+    .name = "tree_sitter.NodeTracker",
+    .basicsize = sizeof(NodeTracker),
+    .itemsize = 0,
+    .flags = Py_TPFLAGS_DEFAULT,
+    .slots = node_tracker_type_slots,
+};
@@ -1,6 +1,16 @@
 #include "types.h"
 
 PyObject *point_new_internal(ModuleState *state, TSPoint point);
+TreeArena *arena_new(void);
+TreeArena *arena_retain(TreeArena *arena);
+void arena_release(TreeArena *arena);
+void arena_mark_shared(TreeArena *arena);
+void arena_set_parent(TreeArena *arena, TreeArena *parent);
+TreeArena *arena_swap(TreeArena *arena);
+MemoryBudget *budget_swap(MemoryBudget *budget);
+AllocatorState allocator_suspend(void);
+void allocator_resume(AllocatorState state);
+bool node_tracker_advance(NodeTracker *self, Tree *old_tree, Tree *new_tree);
 
 #define SET_ATTRIBUTE_ERROR(name)                                                                  \
     (name != NULL && name != Py_None && parser_set_##name(self, name, NULL) < 0)
@@ -16,6 +26,16 @@ typedef struct {
     PyTypeObject *log_type_type;
 } LoggerPayload;
 
+typedef struct {
+    PyObject *callback;
+    MemoryBudget *budget;
+} ProgressPayload;
+
+typedef struct {
+    const char *string;
+    uint32_t length;
+} StringInputPayload;
+
 static void free_logger(const TSParser *parser) {
     TSLogger logger = ts_parser_logger(parser);
     if (logger.payload != NULL) {
@@ -29,6 +49,7 @@ PyObject *parser_new(PyTypeObject *cls, PyObject *Py_UNUSED(args), PyObject *Py_
         self->parser = ts_parser_new();
         self->language = NULL;
         self->logger = NULL;
+        self->peak_memory = 0;
     }
     return (PyObject *)self;
 }
@@ -46,6 +67,8 @@ static const char *parser_read_wrapper(void *payload, uint32_t byte_offset, TSPo
     ReadWrapperPayload *wrapper_payload = (ReadWrapperPayload *)payload;
     PyObject *read_cb = wrapper_payload->read_cb;
     Py_buffer *source_view = wrapper_payload->previous_retval;
+    AllocatorState allocator = allocator_suspend();
+    const char *result = NULL;
 
     // We assume that the parser only needs the return value until the next time
     // this function is called or when ts_parser_parse() returns. We store the
@@ -62,7 +85,7 @@ static const char *parser_read_wrapper(void *payload, uint32_t byte_offset, TSPo
     PyObject *position_obj = point_new_internal(wrapper_payload->state, position);
     if (!position_obj || !byte_offset_obj) {
         *bytes_read = 0;
-        return NULL;
+        goto exit;
     }
 
     PyObject *args = PyTuple_Pack(2, byte_offset_obj, position_obj);
@@ -77,7 +100,7 @@ static const char *parser_read_wrapper(void *payload, uint32_t byte_offset, TSPo
     if (rv == NULL || rv == Py_None) {
         Py_XDECREF(rv);
         *bytes_read = 0;
-        return NULL;
+        goto exit;
     }
 
     // Store buffer in payload.
@@ -86,31 +109,114 @@ static const char *parser_read_wrapper(void *payload, uint32_t byte_offset, TSPo
         Py_XDECREF(rv);
         PyErr_SetString(PyExc_TypeError, "read callable must return a bytestring");
         *bytes_read = 0;
-        return NULL;
+        goto exit;
     }
 
     *bytes_read = (uint32_t)source_view->len;
-    const char *source_bytes = (const char *)source_view->buf;
-    return source_bytes;
+    result = (const char *)source_view->buf;
+
+exit:
+    allocator_resume(allocator);
+    return result;
+}
+
+static const char *string_input_read(void *payload, uint32_t byte_offset,
+                                     TSPoint Py_UNUSED(position), uint32_t *bytes_read) {
+    StringInputPayload *string_input = (StringInputPayload *)payload;
+    if (byte_offset >= string_input->length) {
+        *bytes_read = 0;
+        return "";
+    }
+    *bytes_read = string_input->length - byte_offset;
+    return string_input->string + byte_offset;
 }
 
 static bool parser_progress_callback(TSParseState *state) {
-    PyObject *result = PyObject_CallFunction((PyObject *)state->payload, "Ip",
-                                             state->current_byte_offset, state->has_error);
-    return PyObject_IsTrue(result);
+    ProgressPayload *payload = (ProgressPayload *)state->payload;
+    MemoryBudget *budget = payload->budget;
+    if (budget->limit != 0 && budget->peak > budget->limit) {
+        return true;
+    }
+    if (payload->callback == NULL) {
+        return false;
+    }
+
+    AllocatorState allocator = allocator_suspend();
+    PyObject *result = PyObject_CallFunction(payload->callback, "Ip", state->current_byte_offset,
+                                             state->has_error);
+    allocator_resume(allocator);
+    int cancel = result == NULL || PyObject_IsTrue(result);
+    Py_XDECREF(result);
+    return cancel != 0;
+}
+
+// Arena allocations must not end up in the long-lived parser, so parsing
+// into an arena uses a fresh parser that is discarded along with its state.
+// It gets the language, included ranges and logger of the parser, but not the
+// file for DOT graphs, which the library would close when the parser is deleted.
+static TSParser *parser_begin_parse(Parser *self, TreeArena *arena, MemoryBudget *budget) {
+    budget_swap(budget);
+    if (arena == NULL) {
+        return self->parser;
+    }
+
+    arena_swap(arena);
+    TSParser *parser = ts_parser_new();
+    uint32_t count;
+    const TSRange *ranges = ts_parser_included_ranges(self->parser, &count);
+    ts_parser_set_language(parser, ts_parser_language(self->parser));
+    ts_parser_set_included_ranges(parser, ranges, count);
+    ts_parser_set_logger(parser, ts_parser_logger(self->parser));
+    return parser;
+}
+
+static void parser_end_parse(Parser *self, TSParser *parser, MemoryBudget *budget) {
+    if (parser != self->parser) {
+        ts_parser_delete(parser);
+        arena_swap(NULL);
+    }
+    budget_swap(NULL);
+    self->peak_memory = budget->peak;
 }
 
 PyObject *parser_parse(Parser *self, PyObject *args, PyObject *kwargs) {
     ModuleState *state = GET_MODULE_STATE(self);
     PyObject *source_or_callback;
     PyObject *old_tree_obj = NULL, *encoding_obj = NULL, *progress_callback_obj = NULL;
-    char *keywords[] = {"", "old_tree", "encoding", "progress_callback", NULL};
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O!OO:parse", keywords, &source_or_callback,
-                                     state->tree_type, &old_tree_obj, &encoding_obj,
-                                     &progress_callback_obj)) {
+    PyObject *max_memory_obj = NULL;
+    int use_arena = 0;
+    char *keywords[] = {
+        "", "old_tree", "encoding", "progress_callback", "arena", "max_memory", NULL,
+    };
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O!OO$pO:parse", keywords,
+                                     &source_or_callback, state->tree_type, &old_tree_obj,
+                                     &encoding_obj, &progress_callback_obj, &use_arena,
+                                     &max_memory_obj)) {
         return NULL;
     }
 
+    MemoryBudget budget = {.limit = 0, .used = 0, .peak = 0};
+    if (max_memory_obj != NULL && max_memory_obj != Py_None) {
+        if (!PyLong_Check(max_memory_obj)) {
+            PyErr_Format(PyExc_TypeError, "max_memory must be int or None, not %s",
+                         max_memory_obj->ob_type->tp_name);
+            return NULL;
+        }
+        budget.limit = PyLong_AsSize_t(max_memory_obj);
+        if (budget.limit == (size_t)-1 && PyErr_Occurred()) {
+            return NULL;
+        }
+        if (budget.limit == 0) {
+            PyErr_SetString(PyExc_ValueError, "max_memory must be positive");
+            return NULL;
+        }
+    }
+    ProgressPayload progress = {.callback = NULL, .budget = &budget};
+    TSParseOptions options = {
+        .payload = &progress,
+        .progress_callback = parser_progress_callback,
+    };
+
     const TSTree *old_tree = old_tree_obj ? ((Tree *)old_tree_obj)->tree : NULL;
     TSInputEncoding input_encoding = TSInputEncodingUTF8;
     if (encoding_obj != NULL) {
@@ -136,21 +242,42 @@ PyObject *parser_parse(Parser *self, PyObject *args, PyObject *kwargs) {
         }
     }
 
+    TreeArena *arena = NULL;
+    if (use_arena && (arena = arena_new()) == NULL) {
+        return PyErr_NoMemory();
+    }
+
     TSTree *new_tree = NULL;
+    TSParser *parser;
     Py_buffer source_view;
     if (PyObject_GetBuffer(source_or_callback, &source_view, PyBUF_SIMPLE) > -1) {
         if (progress_callback_obj != NULL) {
             const char *warning = "The progress_callback is ignored when parsing a bytestring";
             if (PyErr_WarnEx(PyExc_UserWarning, warning, 1) < 0) {
                 PyBuffer_Release(&source_view);
+                arena_release(arena);
                 return NULL;
             }
         }
         // parse a buffer
         const char *source_bytes = (const char *)source_view.buf;
         uint32_t length = (uint32_t)source_view.len;
-        new_tree = ts_parser_parse_string_encoding(self->parser, old_tree, source_bytes, length,
-                                                   input_encoding);
+        parser = parser_begin_parse(self, arena, &budget);
+        if (budget.limit == 0) {
+            new_tree = ts_parser_parse_string_encoding(parser, old_tree, source_bytes, length,
+                                                       input_encoding);
+        } else {
+            // the memory limit is only checked by the progress callback
+            StringInputPayload payload = {.string = source_bytes, .length = length};
+            TSInput input = {
+                .payload = &payload,
+                .read = string_input_read,
+                .encoding = input_encoding,
+                .decode = NULL,
+            };
+            new_tree = ts_parser_parse_with_options(parser, old_tree, input, options);
+        }
+        parser_end_parse(self, parser, &budget);
         PyBuffer_Release(&source_view);
     } else if (PyCallable_Check(source_or_callback)) {
         // clear the GetBuffer error
@@ -168,19 +295,20 @@ PyObject *parser_parse(Parser *self, PyObject *args, PyObject *kwargs) {
             .encoding = input_encoding,
             .decode = NULL,
         };
-        if (progress_callback_obj == NULL) {
-            new_tree = ts_parser_parse(self->parser, old_tree, input);
-        } else if (!PyCallable_Check(progress_callback_obj)) {
+        if (progress_callback_obj != NULL && !PyCallable_Check(progress_callback_obj)) {
             PyErr_Format(PyExc_TypeError, "progress_callback must be a callable, not %s",
                          progress_callback_obj->ob_type->tp_name);
+            arena_release(arena);
             return NULL;
+        }
+        progress.callback = progress_callback_obj;
+        parser = parser_begin_parse(self, arena, &budget);
+        if (progress.callback == NULL && budget.limit == 0) {
+            new_tree = ts_parser_parse(parser, old_tree, input);
         } else {
-            TSParseOptions options = {
-                .payload = progress_callback_obj,
-                .progress_callback = parser_progress_callback,
-            };
-            new_tree = ts_parser_parse_with_options(self->parser, old_tree, input, options);
+            new_tree = ts_parser_parse_with_options(parser, old_tree, input, options);
         }
+        parser_end_parse(self, parser, &budget);
         if (source_view.obj) {
             PyBuffer_Release(&source_view);
             source_view.obj = NULL;
@@ -189,27 +317,75 @@ PyObject *parser_parse(Parser *self, PyObject *args, PyObject *kwargs) {
     } else {
         PyErr_Format(PyExc_TypeError, "source must be a bytestring or a callable, not %s",
                      source_or_callback->ob_type->tp_name);
+        arena_release(arena);
         return NULL;
     }
 
-    if (PyErr_Occurred()) {
+    if (new_tree == NULL && budget.limit != 0 && budget.peak > budget.limit) {
+        // discard the partial parse so that the parser can be reused
+        ts_parser_reset(self->parser);
+        arena_release(arena);
+        if (!PyErr_Occurred()) {
+            PyErr_Format(state->memory_limit_exceeded,
+                         "Parsing exceeded the memory limit of %zu bytes", budget.limit);
+        }
         return NULL;
     }
-    if (!new_tree) {
-        PyErr_SetString(PyExc_ValueError, "Parsing failed");
+    if (PyErr_Occurred() || !new_tree) {
+        if (new_tree != NULL) {
+            ts_tree_delete(new_tree);
+        } else if (arena == NULL && old_tree_obj != NULL && ((Tree *)old_tree_obj)->arena) {
+            // The parser keeps nodes of the old tree to resume the parse, but they live
+            // in an arena that is freed along with the old tree.
+            ts_parser_reset(self->parser);
+        }
+        arena_release(arena);
+        if (!PyErr_Occurred()) {
+            PyErr_SetString(PyExc_ValueError, "Parsing failed");
+        }
         return NULL;
     }
 
+    // A tree that reuses nodes of the old tree must keep their memory alive.
+    TreeArena *old_arena = old_tree_obj ? ((Tree *)old_tree_obj)->arena : NULL;
+    if (arena == NULL) {
+        arena = arena_retain(old_arena);
+        arena_mark_shared(arena);
+    } else if (old_tree != NULL) {
+        arena_set_parent(arena, old_arena);
+        arena_mark_shared(arena);
+    }
+
     Tree *tree = PyObject_New(Tree, state->tree_type);
     if (tree == NULL) {
+        ts_tree_delete(new_tree);
+        arena_release(arena);
         return NULL;
     }
     tree->tree = new_tree;
+    tree->arena = arena;
+    tree->index = NULL;
+    tree->tracker = NULL;
+    tree->nodes = NULL;
+    tree->source_view.obj = NULL;
+    tree->char_offsets = NULL;
+    tree->lines = NULL;
     tree->language = self->language;
     tree->source = source_or_callback;
     Py_INCREF(tree->source);
     Py_INCREF(tree->language);
-    return PyObject_Init((PyObject *)tree, state->tree_type);
+    PyObject_Init((PyObject *)tree, state->tree_type);
+
+    // Hand the tracker of the old tree over to the new one.
+    NodeTracker *tracker = old_tree_obj ? ((Tree *)old_tree_obj)->tracker : NULL;
+    if (tracker != NULL && tracker->tree == (Tree *)old_tree_obj) {
+        if (!node_tracker_advance(tracker, (Tree *)old_tree_obj, tree)) {
+            Py_DECREF(tree);
+            return NULL;
+        }
+        tree->tracker = (NodeTracker *)Py_NewRef(tracker);
+    }
+    return (PyObject *)tree;
 }
 
 PyObject *parser_reset(Parser *self, void *Py_UNUSED(payload)) {
@@ -299,6 +475,10 @@ PyObject *parser_get_language(Parser *self, void *Py_UNUSED(payload)) {
     return Py_NewRef(self->language);
 }
 
+PyObject *parser_get_peak_memory(Parser *self, void *Py_UNUSED(payload)) {
+    return PyLong_FromSize_t(self->peak_memory);
+}
+
 PyObject *parser_get_logger(Parser *self, void *Py_UNUSED(payload)) {
     if (!self->logger) {
         Py_RETURN_NONE;
@@ -308,9 +488,11 @@ PyObject *parser_get_logger(Parser *self, void *Py_UNUSED(payload)) {
 
 static void log_callback(void *payload, TSLogType log_type, const char *buffer) {
     LoggerPayload *logger_payload = (LoggerPayload *)payload;
+    AllocatorState allocator = allocator_suspend();
     PyObject *log_type_enum =
         PyObject_CallFunction((PyObject *)logger_payload->log_type_type, "i", log_type);
     PyObject_CallFunction(logger_payload->callback, "Os", log_type_enum, buffer);
+    allocator_resume(allocator);
 }
 
 int parser_set_logger(Parser *self, PyObject *arg, void *Py_UNUSED(payload)) {
@@ -395,13 +577,22 @@ int parser_init(Parser *self, PyObject *args, PyObject *kwargs) {
 
 PyDoc_STRVAR(
     parser_parse_doc,
-    "parse(self, source, /, old_tree=None, encoding=\"utf8\")\n--\n\n"
+    "parse(self, source, /, old_tree=None, encoding=\"utf8\", progress_callback=None, *, "
+    "arena=False, max_memory=None)\n--\n\n"
     "Parse a slice of a bytestring or bytes provided in chunks by a callback.\n\n"
     "The callback function takes a byte offset and position and returns a bytestring starting "
     "at that offset and position. The slices can be of any length. If the given position "
-    "is at the end of the text, the callback should return an empty slice." DOC_RETURNS
+    "is at the end of the text, the callback should return an empty slice.\n\n"
+    "If ``arena`` is true, the nodes of the tree are allocated in a single arena that is released "
+    "at once when the tree is deleted, instead of being freed one by one. Such a parse uses a "
+    "temporary parser, so it does not write DOT graphs and cannot be resumed after it was "
+    "cancelled. A cancelled parse with an ``old_tree`` that was parsed into an arena cannot "
+    "be resumed either, because the parser is reset.\n\n"
+    "If ``max_memory`` is given, the parse is aborted once it has allocated more than that many "
+    "bytes. The parser is reset and can be used again afterwards." DOC_RETURNS
     "A :class:`Tree` if parsing succeeded or ``None`` if the parser does not have an "
-    "assigned language or the timeout expired.");
+    "assigned language or the timeout expired." DOC_RAISES
+    "MemoryLimitExceeded\n\n   If the parse exceeded ``max_memory``.");
 PyDoc_STRVAR(
     parser_reset_doc,
     "reset(self, /)\n--\n\n"
@@ -444,6 +635,9 @@ static PyGetSetDef parser_accessors[] = {
      PyDoc_STR("The ranges of text that the parser will include when parsing."), NULL},
     {"logger", (getter)parser_get_logger, (setter)parser_set_logger,
      PyDoc_STR("The logger that the parser should use during parsing."), NULL},
+    {"peak_memory", (getter)parser_get_peak_memory, NULL,
+     PyDoc_STR("The peak amount of memory, in bytes, that was allocated during the last parse."),
+     NULL},
     {NULL},
 };
 
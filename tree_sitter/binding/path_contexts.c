@@ -0,0 +1,320 @@
+#include "types.h"
+
+#include <string.h>
+
+PyObject *packed_array_new(ModuleState *state, const char *typecode, const void *data,
+                           size_t size);
+bool *language_kind_set_new(Language *self, PyObject *kinds);
+
+typedef struct {
+    void *data;
+    size_t size;
+    size_t capacity;
+} RawVector;
+
+typedef struct {
+    uint32_t index;
+    uint32_t depth;
+} Leaf;
+
+typedef struct {
+    uint32_t pool_start;
+    uint32_t bounds_start;
+} Frame;
+
+// The vectors grow while the GIL is released, hence PyMem_RawRealloc in vector_reserve.
+typedef struct {
+    uint32_t max_length;
+    uint32_t max_width;
+    const bool *leaf_filter;
+    uint32_t kind_count;
+    bool hashed;
+
+    TSSymbol *kinds;
+    uint32_t kinds_capacity;
+    RawVector leaves;
+    RawVector chains;
+    RawVector pool;
+    RawVector bounds;
+    RawVector frames;
+    RawVector contexts;
+    RawVector paths;
+} PathContexts;
+
+static bool vector_reserve(RawVector *self, size_t count, size_t item_size) {
+    if (self->size + count <= self->capacity) {
+        return true;
+    }
+    size_t capacity = self->capacity ? self->capacity * 2 : 64;
+    while (capacity < self->size + count) {
+        capacity *= 2;
+    }
+    void *data = PyMem_RawRealloc(self->data, capacity * item_size);
+    if (data == NULL) {
+        return false;
+    }
+    self->data = data;
+    self->capacity = capacity;
+    return true;
+}
+
+#define VECTOR_PUSH(vector, type, value)                                                           \
+    (vector_reserve(&(vector), 1, sizeof(type))                                                    \
+         ? (((type *)(vector).data)[(vector).size++] = (value), true)                              \
+         : false)
+
+#define VECTOR_AT(vector, type, i) (((type *)(vector).data)[i])
+
+static inline uint64_t hash_step(uint64_t hash, TSSymbol kind, bool down) {
+    return (hash ^ (((uint64_t)kind << 1) | down)) * HASH_PRIME;
+}
+
+// The path goes up from the first leaf to the common ancestor and then down to the second leaf.
+static bool emit_context(PathContexts *self, const Leaf *start, const Leaf *end,
+                         const TSSymbol *start_chain, const TSSymbol *end_chain, uint32_t up,
+                         uint32_t down) {
+    if (self->hashed) {
+        uint64_t hash = HASH_SEED;
+        for (uint32_t i = 0; i <= up; ++i) {
+            hash = hash_step(hash, start_chain[i], false);
+        }
+        for (uint32_t i = down; i-- > 0;) {
+            hash = hash_step(hash, end_chain[i], true);
+        }
+        if (!vector_reserve(&self->contexts, 3, sizeof(uint64_t))) {
+            return false;
+        }
+        uint64_t *context = (uint64_t *)self->contexts.data + self->contexts.size;
+        context[0] = start->index;
+        context[1] = hash;
+        context[2] = end->index;
+        self->contexts.size += 3;
+        return true;
+    }
+
+    uint32_t length = up + 1 + down;
+    if (!vector_reserve(&self->contexts, 5, sizeof(uint32_t)) ||
+        !vector_reserve(&self->paths, length, sizeof(TSSymbol))) {
+        return false;
+    }
+    uint32_t *context = (uint32_t *)self->contexts.data + self->contexts.size;
+    context[0] = start->index;
+    context[1] = end->index;
+    context[2] = (uint32_t)self->paths.size;
+    context[3] = length;
+    context[4] = up;
+    self->contexts.size += 5;
+
+    TSSymbol *path = (TSSymbol *)self->paths.data + self->paths.size;
+    for (uint32_t i = 0; i <= up; ++i) {
+        *path++ = start_chain[i];
+    }
+    for (uint32_t i = down; i-- > 0;) {
+        *path++ = end_chain[i];
+    }
+    self->paths.size += length;
+    return true;
+}
+
+// Combine the leaves of the children of a node whose subtree has been fully visited,
+// then keep the leaves that can still be part of a path through its parent.
+static bool finish_node(PathContexts *self, uint32_t depth) {
+    Frame frame = VECTOR_AT(self->frames, Frame, --self->frames.size);
+    const uint32_t *pool = self->pool.data;
+    const uint32_t *bounds = self->bounds.data;
+    const Leaf *leaves = self->leaves.data;
+    const TSSymbol *chains = self->chains.data;
+    uint32_t stride = self->max_length + 1;
+    uint32_t group_count = (uint32_t)self->bounds.size - frame.bounds_start;
+    uint32_t pool_end = (uint32_t)self->pool.size;
+
+    for (uint32_t i = 0; i < group_count; ++i) {
+        uint32_t i_start = bounds[frame.bounds_start + i];
+        uint32_t i_end = i + 1 < group_count ? bounds[frame.bounds_start + i + 1] : pool_end;
+        uint32_t last =
+            group_count - 1 - i > self->max_width ? i + self->max_width : group_count - 1;
+        for (uint32_t a = i_start; a < i_end; ++a) {
+            const Leaf *start = &leaves[pool[a]];
+            uint32_t up = start->depth - depth;
+            for (uint32_t j = i + 1; j <= last; ++j) {
+                uint32_t j_start = bounds[frame.bounds_start + j];
+                uint32_t j_end =
+                    j + 1 < group_count ? bounds[frame.bounds_start + j + 1] : pool_end;
+                for (uint32_t b = j_start; b < j_end; ++b) {
+                    const Leaf *end = &leaves[pool[b]];
+                    uint32_t down = end->depth - depth;
+                    if (up + down > self->max_length) {
+                        continue;
+                    }
+                    if (!emit_context(self, start, end, chains + (size_t)pool[a] * stride,
+                                      chains + (size_t)pool[b] * stride, up, down)) {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+
+    self->bounds.size = frame.bounds_start;
+    if (depth == 0) {
+        return true;
+    }
+    uint32_t kept = frame.pool_start;
+    for (uint32_t k = frame.pool_start; k < pool_end; ++k) {
+        if (leaves[pool[k]].depth - depth + 1 < self->max_length) {
+            VECTOR_AT(self->pool, uint32_t, kept++) = pool[k];
+        }
+    }
+    self->pool.size = kept;
+    return VECTOR_PUSH(self->bounds, uint32_t, frame.pool_start);
+}
+
+static bool visit_leaf(PathContexts *self, TSNode node, uint32_t index, uint32_t depth) {
+    if (!VECTOR_PUSH(self->bounds, uint32_t, (uint32_t)self->pool.size)) {
+        return false;
+    }
+    TSSymbol symbol = ts_node_symbol(node);
+    if (self->leaf_filter != NULL &&
+        (symbol >= self->kind_count || !self->leaf_filter[symbol])) {
+        return true;
+    }
+
+    uint32_t stride = self->max_length + 1;
+    if (!vector_reserve(&self->chains, stride, sizeof(TSSymbol))) {
+        return false;
+    }
+    TSSymbol *chain = (TSSymbol *)self->chains.data + self->chains.size;
+    for (uint32_t k = 0; k < stride; ++k) {
+        chain[k] = k <= depth ? self->kinds[depth - k] : 0;
+    }
+    self->chains.size += stride;
+
+    Leaf leaf = {.index = index, .depth = depth};
+    uint32_t id = (uint32_t)self->leaves.size;
+    return VECTOR_PUSH(self->leaves, Leaf, leaf) && VECTOR_PUSH(self->pool, uint32_t, id);
+}
+
+static bool collect_path_contexts(PathContexts *self, const TSTree *tree) {
+    bool ok = true;
+    uint32_t index = 0, depth = 0;
+    TSTreeCursor cursor = ts_tree_cursor_new(ts_tree_root_node(tree));
+    for (;;) {
+        TSNode node = ts_tree_cursor_current_node(&cursor);
+        if (depth >= self->kinds_capacity) {
+            uint32_t capacity = self->kinds_capacity ? self->kinds_capacity * 2 : 64;
+            TSSymbol *kinds = PyMem_RawRealloc(self->kinds, capacity * sizeof(TSSymbol));
+            if (kinds == NULL) {
+                ok = false;
+                break;
+            }
+            self->kinds = kinds;
+            self->kinds_capacity = capacity;
+        }
+        self->kinds[depth] = ts_node_symbol(node);
+
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            Frame frame = {
+                .pool_start = (uint32_t)self->pool.size,
+                .bounds_start = (uint32_t)self->bounds.size,
+            };
+            if (!(ok = VECTOR_PUSH(self->frames, Frame, frame))) {
+                break;
+            }
+            index++;
+            depth++;
+            continue;
+        }
+        if (depth > 0 && !(ok = visit_leaf(self, node, index, depth))) {
+            break;
+        }
+        index++;
+        while (ok && !ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                goto done;
+            }
+            ok = finish_node(self, --depth);
+        }
+        if (!ok) {
+            break;
+        }
+    }
+
+done:
+    ts_tree_cursor_delete(&cursor);
+    return ok;
+}
+
+static void path_contexts_free(PathContexts *self) {
+    PyMem_RawFree(self->kinds);
+    PyMem_RawFree(self->leaves.data);
+    PyMem_RawFree(self->chains.data);
+    PyMem_RawFree(self->pool.data);
+    PyMem_RawFree(self->bounds.data);
+    PyMem_RawFree(self->frames.data);
+    PyMem_RawFree(self->contexts.data);
+    PyMem_RawFree(self->paths.data);
+}
+
+PyObject *tree_path_contexts(Tree *self, PyObject *args, PyObject *kwargs) {
+    ModuleState *state = GET_MODULE_STATE(self);
+    uint32_t max_length = 8, max_width = 2;
+    int hashed = 1;
+    PyObject *leaf_filter_obj = Py_None;
+    char *keywords[] = {"max_length", "max_width", "leaf_filter", "hashed", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|II$Op:path_contexts", keywords,
+                                     &max_length, &max_width, &leaf_filter_obj, &hashed)) {
+        return NULL;
+    }
+    if (max_length < 2 || max_length > UINT16_MAX) {
+        PyErr_SetString(PyExc_ValueError, "max_length must be between 2 and 65535");
+        return NULL;
+    }
+    if (max_width < 1) {
+        PyErr_SetString(PyExc_ValueError, "max_width must be positive");
+        return NULL;
+    }
+
+    PathContexts contexts = {
+        .max_length = max_length,
+        .max_width = max_width,
+        .kind_count = ts_language_symbol_count(ts_tree_language(self->tree)),
+        .hashed = hashed,
+    };
+    bool *leaf_filter = NULL;
+    if (leaf_filter_obj != Py_None) {
+        leaf_filter = language_kind_set_new((Language *)self->language, leaf_filter_obj);
+        if (leaf_filter == NULL) {
+            return NULL;
+        }
+        contexts.leaf_filter = leaf_filter;
+    }
+
+    // Another thread may edit the tree while the GIL is released.
+    TSTree *tree = ts_tree_copy(self->tree);
+    bool ok;
+    Py_BEGIN_ALLOW_THREADS
+    ok = collect_path_contexts(&contexts, tree);
+    Py_END_ALLOW_THREADS
+    ts_tree_delete(tree);
+    PyMem_RawFree(leaf_filter);
+    if (!ok) {
+        path_contexts_free(&contexts);
+        return PyErr_NoMemory();
+    }
+
+    PyObject *result;
+    if (hashed) {
+        result = packed_array_new(state, "Q", contexts.contexts.data,
+                                  contexts.contexts.size * sizeof(uint64_t));
+    } else {
+        PyObject *items = packed_array_new(state, "I", contexts.contexts.data,
+                                           contexts.contexts.size * sizeof(uint32_t));
+        PyObject *paths = packed_array_new(state, "H", contexts.paths.data,
+                                           contexts.paths.size * sizeof(TSSymbol));
+        result = items && paths ? PyTuple_Pack(2, items, paths) : NULL;
+        Py_XDECREF(items);
+        Py_XDECREF(paths);
+    }
+    path_contexts_free(&contexts);
+    return result;
+}
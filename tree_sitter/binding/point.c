@@ -1,5 +1,8 @@
 #include "types.h"
 
+PyObject *vectorcall_fallback(PyObject *callable, PyObject *const *args, Py_ssize_t nargs,
+                              PyObject *kwnames);
+
 PyObject *point_new_internal(ModuleState *state, TSPoint point) {
     PyObject *self = PyTuple_New(2);
     if (self == NULL) {
@@ -26,6 +29,22 @@ PyObject *point_new(PyTypeObject *type, PyObject *args, PyObject *kwargs) {
     return PyObject_Init(self, type);
 }
 
+// Skip the argument tuple of tp_new for positional calls.
+PyObject *point_vectorcall(PyObject *type, PyObject *const *args, size_t nargsf,
+                           PyObject *kwnames) {
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (kwnames != NULL || nargs != 2 || !PyLong_CheckExact(args[0]) ||
+        !PyLong_CheckExact(args[1])) {
+        return vectorcall_fallback(type, args, nargs, kwnames);
+    }
+
+    TSPoint point;
+    if (!arg_as_uint32(args[0], &point.row) || !arg_as_uint32(args[1], &point.column)) {
+        return NULL;
+    }
+    return point_new_internal(PyType_GetModuleState((PyTypeObject *)type), point);
+}
+
 PyObject *point_repr(PyObject *self) {
     uint32_t row = PyLong_AsUnsignedLong(PyTuple_GET_ITEM(self, 0)),
              column = PyLong_AsUnsignedLong(PyTuple_GET_ITEM(self, 1));
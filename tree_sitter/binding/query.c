@@ -30,6 +30,7 @@ void query_dealloc(Query *self) {
     Py_XDECREF(self->predicates);
     Py_XDECREF(self->settings);
     Py_XDECREF(self->assertions);
+    Py_XDECREF(self->capture_names);
     Py_TYPE(self)->tp_free(self);
 }
 
@@ -57,6 +58,7 @@ PyObject *query_new(PyTypeObject *cls, PyObject *args, PyObject *Py_UNUSED(kwarg
     query->predicates = NULL;
     query->settings = NULL;
     query->assertions = NULL;
+    query->capture_names = NULL;
 
     if (!query->query) {
         uint32_t start = 0, end = 0, row = 0, column;
@@ -132,7 +134,22 @@ PyObject *query_new(PyTypeObject *cls, PyObject *args, PyObject *Py_UNUSED(kwarg
         goto error;
     }
 
-    uint32_t length, pattern_count = ts_query_pattern_count(query->query);
+    uint32_t length, capture_count = ts_query_capture_count(query->query);
+    query->capture_names = PyTuple_New(capture_count);
+    if (query->capture_names == NULL) {
+        goto error;
+    }
+    for (uint32_t i = 0; i < capture_count; ++i) {
+        const char *capture_name = ts_query_capture_name_for_id(query->query, i, &length);
+        PyObject *capture_name_obj = PyUnicode_FromStringAndSize(capture_name, length);
+        if (capture_name_obj == NULL) {
+            goto error;
+        }
+        PyUnicode_InternInPlace(&capture_name_obj);
+        PyTuple_SET_ITEM(query->capture_names, i, capture_name_obj);
+    }
+
+    uint32_t pattern_count = ts_query_pattern_count(query->query);
     query->predicates = PyList_New(pattern_count);
     if (query->predicates == NULL) {
         goto error;
@@ -480,7 +497,7 @@ error:
 }
 
 PyObject *query_capture_name(Query *self, PyObject *args) {
-    uint32_t index, length, count;
+    uint32_t index, count;
     if (!PyArg_ParseTuple(args, "I:capture_name", &index)) {
         return NULL;
     }
@@ -489,8 +506,7 @@ PyObject *query_capture_name(Query *self, PyObject *args) {
         PyErr_Format(PyExc_IndexError, "Index %u exceeds count %u", index, count);
         return NULL;
     }
-    const char *capture = ts_query_capture_name_for_id(self->query, index, &length);
-    return PyUnicode_FromStringAndSize(capture, length);
+    return Py_NewRef(PyTuple_GET_ITEM(self->capture_names, index));
 }
 
 PyObject *query_capture_quantifier(Query *self, PyObject *args) {
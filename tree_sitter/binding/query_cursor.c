@@ -35,18 +35,20 @@ int query_cursor_init(QueryCursor *self, PyObject *args, PyObject *kwargs) {
     return 0;
 }
 
-PyObject *query_cursor_set_max_start_depth(QueryCursor *self, PyObject *args) {
+PyObject *query_cursor_set_max_start_depth(QueryCursor *self, PyObject *arg) {
     uint32_t max_start_depth;
-    if (!PyArg_ParseTuple(args, "I:set_max_start_depth", &max_start_depth)) {
+    if (!arg_as_uint32(arg, &max_start_depth)) {
         return NULL;
     }
     ts_query_cursor_set_max_start_depth(self->cursor, max_start_depth);
     return Py_NewRef(self);
 }
 
-PyObject *query_cursor_set_byte_range(QueryCursor *self, PyObject *args) {
+PyObject *query_cursor_set_byte_range(QueryCursor *self, PyObject *const *args,
+                                      Py_ssize_t nargs) {
     uint32_t start_byte, end_byte;
-    if (!PyArg_ParseTuple(args, "II:set_byte_range", &start_byte, &end_byte)) {
+    if (!check_arg_count("set_byte_range", nargs, 2) || !arg_as_uint32(args[0], &start_byte) ||
+        !arg_as_uint32(args[1], &end_byte)) {
         return NULL;
     }
     if (!ts_query_cursor_set_byte_range(self->cursor, start_byte, end_byte)) {
@@ -56,9 +58,11 @@ PyObject *query_cursor_set_byte_range(QueryCursor *self, PyObject *args) {
     return Py_NewRef(self);
 }
 
-PyObject *query_cursor_set_containing_byte_range(QueryCursor *self, PyObject *args) {
+PyObject *query_cursor_set_containing_byte_range(QueryCursor *self, PyObject *const *args,
+                                                 Py_ssize_t nargs) {
     uint32_t start_byte, end_byte;
-    if (!PyArg_ParseTuple(args, "II:set_containing_byte_range", &start_byte, &end_byte)) {
+    if (!check_arg_count("set_containing_byte_range", nargs, 2) ||
+        !arg_as_uint32(args[0], &start_byte) || !arg_as_uint32(args[1], &end_byte)) {
         return NULL;
     }
     if (!ts_query_cursor_set_containing_byte_range(self->cursor, start_byte, end_byte)) {
@@ -68,10 +72,11 @@ PyObject *query_cursor_set_containing_byte_range(QueryCursor *self, PyObject *ar
     return Py_NewRef(self);
 }
 
-PyObject *query_cursor_set_point_range(QueryCursor *self, PyObject *args) {
+PyObject *query_cursor_set_point_range(QueryCursor *self, PyObject *const *args,
+                                       Py_ssize_t nargs) {
     TSPoint start_point, end_point;
-    if (!PyArg_ParseTuple(args, "(II)(II):set_point_range", &start_point.row, &start_point.column,
-                          &end_point.row, &end_point.column)) {
+    if (!check_arg_count("set_point_range", nargs, 2) || !arg_as_point(args[0], &start_point) ||
+        !arg_as_point(args[1], &end_point)) {
         return NULL;
     }
     if (!ts_query_cursor_set_point_range(self->cursor, start_point, end_point)) {
@@ -81,10 +86,11 @@ PyObject *query_cursor_set_point_range(QueryCursor *self, PyObject *args) {
     return Py_NewRef(self);
 }
 
-PyObject *query_cursor_set_containing_point_range(QueryCursor *self, PyObject *args) {
+PyObject *query_cursor_set_containing_point_range(QueryCursor *self, PyObject *const *args,
+                                                  Py_ssize_t nargs) {
     TSPoint start_point, end_point;
-    if (!PyArg_ParseTuple(args, "(II)(II):set_containing_point_range", &start_point.row,
-                          &start_point.column, &end_point.row, &end_point.column)) {
+    if (!check_arg_count("set_containing_point_range", nargs, 2) ||
+        !arg_as_point(args[0], &start_point) || !arg_as_point(args[1], &end_point)) {
         return NULL;
     }
     if (!ts_query_cursor_set_containing_point_range(self->cursor, start_point, end_point)) {
@@ -125,7 +131,6 @@ PyObject *query_cursor_matches(QueryCursor *self, PyObject *args, PyObject *kwar
     }
 
     TSQueryMatch match;
-    uint32_t name_length;
     Node *node = (Node *)node_obj;
     Query *query = (Query *)self->query;
     if (progress_callback_obj == NULL) {
@@ -145,14 +150,11 @@ PyObject *query_cursor_matches(QueryCursor *self, PyObject *args, PyObject *kwar
         PyObject *captures_for_match = PyDict_New();
         for (uint16_t i = 0; i < match.capture_count; ++i) {
             TSQueryCapture capture = match.captures[i];
-            const char *capture_name =
-                ts_query_capture_name_for_id(query->query, capture.index, &name_length);
-            PyObject *capture_name_obj = PyUnicode_FromStringAndSize(capture_name, name_length);
+            PyObject *capture_name_obj = PyTuple_GET_ITEM(query->capture_names, capture.index);
             PyObject *capture_node = node_new_internal(state, capture.node, node->tree);
             PyObject *default_list = PyList_New(0);
             PyObject *capture_list =
                 PyDict_SetDefault(captures_for_match, capture_name_obj, default_list);
-            Py_DECREF(capture_name_obj);
             Py_DECREF(default_list);
             PyList_Append(capture_list, capture_node);
             Py_XDECREF(capture_node);
@@ -194,7 +196,6 @@ PyObject *query_cursor_captures(QueryCursor *self, PyObject *args, PyObject *kwa
 
     uint32_t capture_index;
     TSQueryMatch match;
-    uint32_t name_length;
     Node *node = (Node *)node_obj;
     Query *query = (Query *)self->query;
     if (progress_callback_obj == NULL) {
@@ -215,13 +216,10 @@ PyObject *query_cursor_captures(QueryCursor *self, PyObject *args, PyObject *kwa
         }
 
         TSQueryCapture capture = match.captures[capture_index];
-        const char *capture_name =
-            ts_query_capture_name_for_id(query->query, capture.index, &name_length);
-        PyObject *capture_name_obj = PyUnicode_FromStringAndSize(capture_name, name_length);
+        PyObject *capture_name_obj = PyTuple_GET_ITEM(query->capture_names, capture.index);
         PyObject *capture_node = node_new_internal(state, capture.node, node->tree);
         PyObject *default_set = PySet_New(NULL);
         PyObject *capture_set = PyDict_SetDefault(result, capture_name_obj, default_set);
-        Py_DECREF(capture_name_obj);
         Py_DECREF(default_set);
         PySet_Add(capture_set, capture_node);
         Py_XDECREF(capture_node);
@@ -311,31 +309,31 @@ static PyMethodDef query_cursor_methods[] = {
     {
         .ml_name = "set_max_start_depth",
         .ml_meth = (PyCFunction)query_cursor_set_max_start_depth,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = query_cursor_set_max_start_depth_doc,
     },
     {
         .ml_name = "set_byte_range",
         .ml_meth = (PyCFunction)query_cursor_set_byte_range,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_FASTCALL,
         .ml_doc = query_cursor_set_byte_range_doc,
     },
     {
         .ml_name = "set_containing_byte_range",
         .ml_meth = (PyCFunction)query_cursor_set_containing_byte_range,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_FASTCALL,
         .ml_doc = query_cursor_set_containing_byte_range_doc,
     },
     {
         .ml_name = "set_point_range",
         .ml_meth = (PyCFunction)query_cursor_set_point_range,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_FASTCALL,
         .ml_doc = query_cursor_set_point_range_doc,
     },
     {
         .ml_name = "set_containing_point_range",
         .ml_meth = (PyCFunction)query_cursor_set_containing_point_range,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_FASTCALL,
         .ml_doc = query_cursor_set_containing_point_range_doc,
     },
     {
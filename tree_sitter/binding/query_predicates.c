@@ -26,31 +26,22 @@ static inline PyObject *nodes_for_capture_index(ModuleState *state, uint32_t ind
     return result;
 }
 
-static inline PyObject *captures_for_match(ModuleState *state, TSQuery *query, TSQueryMatch *match,
+static inline PyObject *captures_for_match(ModuleState *state, Query *query, TSQueryMatch *match,
                                            Tree *tree) {
-    uint32_t name_length;
     PyObject *captures = PyDict_New();
     for (uint32_t j = 0; j < match->capture_count; ++j) {
         TSQueryCapture capture = match->captures[j];
-        const char *capture_name = ts_query_capture_name_for_id(query, capture.index, &name_length);
-        PyObject *capture_name_obj = PyUnicode_FromStringAndSize(capture_name, name_length);
-        if (capture_name_obj == NULL) {
-            Py_DECREF(captures);
-            return NULL;
-        }
+        PyObject *capture_name_obj = PyTuple_GET_ITEM(query->capture_names, capture.index);
         PyObject *nodes = nodes_for_capture_index(state, capture.index, match, tree);
         if (nodes == NULL) {
             Py_DECREF(captures);
-            Py_DECREF(capture_name_obj);
             return NULL;
         }
         if (PyDict_SetItem(captures, capture_name_obj, nodes) == -1) {
             Py_DECREF(captures);
-            Py_DECREF(capture_name_obj);
             Py_DECREF(nodes);
             return NULL;
         }
-        Py_DECREF(capture_name_obj);
         Py_DECREF(nodes);
     }
     return captures;
@@ -163,7 +154,7 @@ bool query_satisfies_predicates(Query *query, TSQueryMatch match, Tree *tree, Py
         } else if (IS_INSTANCE_OF(item, state->query_predicate_match_type)) {
             is_satisfied = satisfies_match(state, (QueryPredicateMatch *)item, &match, tree);
         } else if (callable != NULL) {
-            PyObject *captures = captures_for_match(state, query->query, &match, tree);
+            PyObject *captures = captures_for_match(state, query, &match, tree);
             if (captures == NULL) {
                 is_satisfied = false;
                 break;
@@ -1,36 +1,66 @@
 #include "types.h"
 
 PyObject *point_new_internal(ModuleState *state, TSPoint point);
+PyObject *vectorcall_fallback(PyObject *callable, PyObject *const *args, Py_ssize_t nargs,
+                              PyObject *kwnames);
+
+static bool range_check(const TSRange *range) {
+    TSPoint start = range->start_point, end = range->end_point;
+    if (start.row > end.row || (start.row == end.row && start.column > end.column)) {
+        PyErr_Format(PyExc_ValueError, "Invalid point range: (%u, %u) to (%u, %u)", start.row,
+                     start.column, end.row, end.column);
+        return false;
+    }
+
+    if (range->start_byte > range->end_byte) {
+        PyErr_Format(PyExc_ValueError, "Invalid byte range: %u to %u", range->start_byte,
+                     range->end_byte);
+        return false;
+    }
+    return true;
+}
 
 int range_init(Range *self, PyObject *args, PyObject *kwargs) {
-    uint32_t start_row, start_col, end_row, end_col, start_byte, end_byte;
+    TSRange range;
     char *keywords[] = {
         "start_point", "end_point", "start_byte", "end_byte", NULL,
     };
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "(II)(II)II:__init__", keywords, &start_row,
-                                     &start_col, &end_row, &end_col, &start_byte, &end_byte)) {
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "(II)(II)II:__init__", keywords,
+                                     &range.start_point.row, &range.start_point.column,
+                                     &range.end_point.row, &range.end_point.column,
+                                     &range.start_byte, &range.end_byte)) {
         return -1;
     }
-
-    if (start_row > end_row || (start_row == end_row && start_col > end_col)) {
-        PyErr_Format(PyExc_ValueError, "Invalid point range: (%u, %u) to (%u, %u)", start_row,
-                     start_col, end_row, end_col);
+    if (!range_check(&range)) {
         return -1;
     }
 
-    if (start_byte > end_byte) {
-        PyErr_Format(PyExc_ValueError, "Invalid byte range: %u to %u", start_byte, end_byte);
-        return -1;
+    self->range = range;
+    return 0;
+}
+
+// Skip the argument tuple and dict of tp_new and tp_init for positional calls.
+PyObject *range_vectorcall(PyObject *type, PyObject *const *args, size_t nargsf,
+                           PyObject *kwnames) {
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (kwnames != NULL || nargs != 4 || !PyTuple_Check(args[0]) || !PyTuple_Check(args[1]) ||
+        !PyLong_CheckExact(args[2]) || !PyLong_CheckExact(args[3])) {
+        return vectorcall_fallback(type, args, nargs, kwnames);
     }
 
-    self->range.start_point.row = start_row;
-    self->range.start_point.column = start_col;
-    self->range.end_point.row = end_row;
-    self->range.end_point.column = end_col;
-    self->range.start_byte = start_byte;
-    self->range.end_byte = end_byte;
+    TSRange range;
+    if (!arg_as_point(args[0], &range.start_point) || !arg_as_point(args[1], &range.end_point) ||
+        !arg_as_uint32(args[2], &range.start_byte) || !arg_as_uint32(args[3], &range.end_byte) ||
+        !range_check(&range)) {
+        return NULL;
+    }
 
-    return 0;
+    Range *self = PyObject_New(Range, (PyTypeObject *)type);
+    if (self == NULL) {
+        return NULL;
+    }
+    self->range = range;
+    return PyObject_Init((PyObject *)self, (PyTypeObject *)type);
 }
 
 void range_dealloc(Range *self) { Py_TYPE(self)->tp_free(self); }
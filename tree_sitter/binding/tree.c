@@ -1,14 +1,223 @@
 #include "types.h"
 
+#include <string.h>
+
+#define SOURCE_CACHE_LIMIT (64u * 1024u * 1024u)
+
+#define CHAR_OFFSET_INTERVAL 512
+
 PyObject *node_new_internal(ModuleState *state, TSNode node, PyObject *tree);
+PyObject *point_new_internal(ModuleState *state, TSPoint point);
+void allocator_free(void *ptr);
+TreeArena *arena_retain(TreeArena *arena);
+void arena_mark_shared(TreeArena *arena);
+void arena_delete_tree(TreeArena *arena, TSTree *tree);
+TreeIndex *tree_index_get(Tree *tree);
+void tree_index_clear(Tree *tree);
+bool tree_index_compute_hashes(TreeIndex *index, const char *text, uint32_t length);
+bool node_tracker_rekey(NodeTracker *self, const TSTree *old_tree, const TSTree *new_tree);
+void node_tracker_detach(NodeTracker *self, Tree *tree);
+NodeTable *node_table_new(void);
+void node_table_delete(NodeTable *table);
+void node_table_clear(NodeTable *table);
+PyObject *tree_path_contexts(Tree *self, PyObject *args, PyObject *kwargs);
+void line_index_delete(LineIndex *index);
+PyObject *tree_to_utf16_point(Tree *self, PyObject *arg);
+PyObject *tree_from_utf16_point(Tree *self, PyObject *arg);
+PyObject *tree_to_utf16_points(Tree *self, PyObject *arg);
+PyObject *tree_from_utf16_points(Tree *self, PyObject *arg);
+bool *language_kind_set_new(Language *self, PyObject *kinds);
+PyObject *packed_array_new(ModuleState *state, const char *typecode, const void *data,
+                           size_t size);
+
+typedef struct {
+    uint32_t *kinds;
+    uint32_t kind_count;
+    uint32_t *depths;
+    uint32_t depth_count;
+    uint32_t depth_capacity;
+    uint64_t named;
+    uint64_t anonymous;
+    uint64_t extra;
+    uint64_t errors;
+    uint64_t missing;
+    uint64_t covered_bytes;
+    uint64_t error_bytes;
+} TreeStats;
+
+typedef struct {
+    uint32_t max_bytes;
+    uint32_t overlap;
+    const bool *prefer_kinds;
+    uint32_t kind_count;
+    const unsigned char *text;
+    uint32_t text_length;
+    uint32_t *ranges;
+    size_t size;
+    size_t capacity;
+    uint32_t start_byte;
+    uint32_t end_byte;
+    bool pending;
+} TreeChunker;
 
 void tree_dealloc(Tree *self) {
-    ts_tree_delete(self->tree);
+    tree_index_clear(self);
+    if (self->tracker != NULL) {
+        node_tracker_detach(self->tracker, self);
+        Py_DECREF(self->tracker);
+    }
+    node_table_delete(self->nodes);
+    if (self->source_view.obj != NULL) {
+        PyBuffer_Release(&self->source_view);
+    }
+    PyMem_Free(self->char_offsets);
+    line_index_delete(self->lines);
+    arena_delete_tree(self->arena, self->tree);
     Py_XDECREF(self->language);
     Py_XDECREF(self->source);
     Py_TYPE(self)->tp_free(self);
 }
 
+// Read the text between two offsets from a read callback into the given buffer.
+// Returns the number of bytes read, which is smaller if the callback ran out of text.
+Py_ssize_t tree_read_source(Tree *self, uint32_t start_byte, TSPoint start_point,
+                            uint32_t end_byte, char *buffer) {
+    ModuleState *state = GET_MODULE_STATE(self);
+    uint32_t offset = start_byte;
+    TSPoint point = start_point;
+    while (offset < end_byte) {
+        PyObject *point_obj = point_new_internal(state, point);
+        if (point_obj == NULL) {
+            return -1;
+        }
+        PyObject *chunk = PyObject_CallFunction(self->source, "IN", offset, point_obj);
+        if (chunk == NULL) {
+            return -1;
+        }
+        if (chunk == Py_None) {
+            Py_DECREF(chunk);
+            break;
+        }
+        Py_buffer chunk_view;
+        if (PyObject_GetBuffer(chunk, &chunk_view, PyBUF_SIMPLE) < 0) {
+            Py_DECREF(chunk);
+            return -1;
+        }
+        Py_DECREF(chunk);
+        if (chunk_view.len == 0) {
+            PyBuffer_Release(&chunk_view);
+            break;
+        }
+
+        const char *text = chunk_view.buf;
+        uint32_t length = (uint32_t)Py_MIN((size_t)chunk_view.len, (size_t)(end_byte - offset));
+        memcpy(buffer + (offset - start_byte), text, length);
+        const char *line = text, *end = text + length, *newline;
+        while ((newline = memchr(line, '\n', end - line)) != NULL) {
+            point.row++;
+            line = newline + 1;
+        }
+        point.column = line == text ? point.column + length : (uint32_t)(end - line);
+        offset += length;
+        PyBuffer_Release(&chunk_view);
+    }
+    return (Py_ssize_t)(offset - start_byte);
+}
+
+static PyObject *tree_read_all_source(Tree *self) {
+    uint32_t length = ts_node_end_byte(ts_tree_root_node(self->tree));
+    PyObject *text = PyBytes_FromStringAndSize(NULL, length);
+    if (text == NULL) {
+        return NULL;
+    }
+    TSPoint start_point = {0, 0};
+    Py_ssize_t read = tree_read_source(self, 0, start_point, length, PyBytes_AS_STRING(text));
+    if (read < 0) {
+        Py_DECREF(text);
+        return NULL;
+    }
+    if (read < length) {
+        Py_SETREF(text, PyBytes_FromStringAndSize(PyBytes_AS_STRING(text), read));
+    }
+    return text;
+}
+
+// The buffer is acquired on first use and kept until the tree is edited or deleted.
+// Other sources than bytes are copied once, since an export would keep a bytearray from
+// being resized. The text of a read callback is read once, unless it is too large.
+const Py_buffer *tree_get_source_view(Tree *self) {
+    if (self->source_view.obj != NULL) {
+        return &self->source_view;
+    }
+    if (self->source == NULL || self->source == Py_None) {
+        return NULL;
+    }
+
+    PyObject *source;
+    if (PyBytes_CheckExact(self->source)) {
+        source = Py_NewRef(self->source);
+    } else if (PyObject_CheckBuffer(self->source)) {
+        source = PyBytes_FromObject(self->source);
+        if (source == NULL) {
+            return NULL;
+        }
+    } else if (ts_node_end_byte(ts_tree_root_node(self->tree)) <= SOURCE_CACHE_LIMIT) {
+        source = tree_read_all_source(self);
+        if (source == NULL) {
+            return NULL;
+        }
+    } else {
+        return NULL;
+    }
+    int result = PyObject_GetBuffer(source, &self->source_view, PyBUF_SIMPLE);
+    Py_DECREF(source);
+    if (result < 0) {
+        self->source_view.obj = NULL;
+        return NULL;
+    }
+    return &self->source_view;
+}
+
+// Count the code points in UTF-8 text by skipping its continuation bytes, a word at a time.
+static uint32_t count_chars(const char *text, uint32_t length) {
+    uint32_t continuation = 0, i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, text + i, 8);
+        uint64_t mask = (word & ~(word << 1) & 0x8080808080808080ULL) >> 7;
+        continuation += (uint32_t)((mask * 0x0101010101010101ULL) >> 56);
+    }
+    for (; i < length; ++i) {
+        continuation += ((uint8_t)text[i] & 0xC0) == 0x80;
+    }
+    return length - continuation;
+}
+
+// Convert a byte offset into the source to a code point offset, using the number of code points
+// before every CHAR_OFFSET_INTERVAL bytes that are counted on first use.
+Py_ssize_t tree_char_offset(Tree *self, const Py_buffer *view, uint32_t byte) {
+    const char *text = view->buf;
+    uint32_t length = (uint32_t)view->len;
+    if (self->char_offsets == NULL) {
+        uint32_t count = length / CHAR_OFFSET_INTERVAL + 1;
+        self->char_offsets = PyMem_Malloc(count * sizeof(uint32_t));
+        if (self->char_offsets == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        self->char_offsets[0] = 0;
+        for (uint32_t i = 1; i < count; ++i) {
+            self->char_offsets[i] =
+                self->char_offsets[i - 1] +
+                count_chars(text + (i - 1) * CHAR_OFFSET_INTERVAL, CHAR_OFFSET_INTERVAL);
+        }
+    }
+    byte = byte < length ? byte : length;
+    uint32_t checkpoint = byte / CHAR_OFFSET_INTERVAL * CHAR_OFFSET_INTERVAL;
+    return self->char_offsets[byte / CHAR_OFFSET_INTERVAL] +
+           count_chars(text + checkpoint, byte - checkpoint);
+}
+
 PyObject *tree_get_root_node(Tree *self, void *Py_UNUSED(payload)) {
     ModuleState *state = GET_MODULE_STATE(self);
     TSNode node = ts_tree_root_node(self->tree);
@@ -70,22 +279,62 @@ PyObject *tree_edit(Tree *self, PyObject *args, PyObject *kwargs) {
         .new_end_point = {new_end_row, new_end_column},
     };
 
+    // the edited subtrees are allocated outside of the arena
+    arena_mark_shared(self->arena);
+    // keep the subtrees from before the edit alive to look up their ids
+    TSTree *old_tree = NULL;
+    if (self->tracker != NULL && self->tracker->tree == self) {
+        old_tree = ts_tree_copy(self->tree);
+    }
     ts_tree_edit(self->tree, &edit);
+    tree_index_clear(self);
+    // the positions of existing nodes are now stale
+    node_table_clear(self->nodes);
 
+    if (self->source_view.obj != NULL) {
+        PyBuffer_Release(&self->source_view);
+        self->source_view.obj = NULL;
+    }
+    PyMem_Free(self->char_offsets);
+    self->char_offsets = NULL;
+    line_index_delete(self->lines);
+    self->lines = NULL;
     Py_XDECREF(self->source);
     self->source = Py_None;
     Py_INCREF(self->source);
+
+    // the tree is consistent by now, even if the tracker fails and lets go of it
+    if (old_tree != NULL) {
+        bool ok = node_tracker_rekey(self->tracker, old_tree, self->tree);
+        ts_tree_delete(old_tree);
+        if (!ok) {
+            return NULL;
+        }
+    }
     Py_RETURN_NONE;
 }
 
 PyObject *tree_copy(Tree *self, PyObject *Py_UNUSED(args)) {
     ModuleState *state = GET_MODULE_STATE(self);
+    NodeTable *nodes = NULL;
+    if (self->nodes != NULL && (nodes = node_table_new()) == NULL) {
+        return PyErr_NoMemory();
+    }
     Tree *copied = PyObject_New(Tree, state->tree_type);
     if (copied == NULL) {
+        node_table_delete(nodes);
         return NULL;
     }
 
     copied->tree = ts_tree_copy(self->tree);
+    copied->arena = arena_retain(self->arena);
+    copied->index = NULL;
+    copied->tracker = NULL;
+    copied->nodes = nodes;
+    copied->source_view.obj = NULL;
+    copied->char_offsets = NULL;
+    copied->lines = NULL;
+    arena_mark_shared(self->arena);
     copied->language = self->language;
     Py_XINCREF(self->language);
     copied->source = self->source;
@@ -130,7 +379,7 @@ PyObject *tree_changed_ranges(Tree *self, PyObject *args, PyObject *kwargs) {
         PyList_SetItem(result, i, PyObject_Init((PyObject *)range, state->range_type));
     }
 
-    PyMem_Free(ranges);
+    allocator_free(ranges);
     return result;
 }
 
@@ -152,10 +401,684 @@ PyObject *tree_get_included_ranges(Tree *self, PyObject *Py_UNUSED(args)) {
         PyList_SetItem(result, i, PyObject_Init((PyObject *)range, state->range_type));
     }
 
-    PyMem_Free(ranges);
+    allocator_free(ranges);
     return result;
 }
 
+PyObject *tree_build_parent_index(Tree *self, PyObject *Py_UNUSED(args)) {
+    if (tree_index_get(self) == NULL) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+PyObject *tree_compute_hashes(Tree *self, PyObject *args, PyObject *kwargs) {
+    int include_text = 1;
+    char *keywords[] = {"include_text", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|p:compute_hashes", keywords,
+                                     &include_text)) {
+        return NULL;
+    }
+
+    TreeIndex *index = tree_index_get(self);
+    if (index == NULL) {
+        return NULL;
+    }
+    if (index->hashes != NULL && index->hashes_include_text == (bool)include_text) {
+        Py_RETURN_NONE;
+    }
+
+    const Py_buffer *view = NULL;
+    if (include_text && (view = tree_get_source_view(self)) == NULL) {
+        if (!PyErr_Occurred()) {
+            PyErr_SetString(PyExc_ValueError,
+                            "include_text requires the source of the tree to be available");
+        }
+        return NULL;
+    }
+
+    const char *text = view != NULL ? (const char *)view->buf : NULL;
+    bool ok = tree_index_compute_hashes(index, text, view != NULL ? (uint32_t)view->len : 0);
+    if (!ok) {
+        return PyErr_NoMemory();
+    }
+    Py_RETURN_NONE;
+}
+
+PyObject *tree_errors(Tree *self, PyObject *args, PyObject *kwargs) {
+    ModuleState *state = GET_MODULE_STATE(self);
+    PyObject *limit_obj = Py_None;
+    char *keywords[] = {"limit", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O:errors", keywords, &limit_obj)) {
+        return NULL;
+    }
+
+    Py_ssize_t limit = PY_SSIZE_T_MAX;
+    if (limit_obj != Py_None) {
+        limit = PyLong_AsSsize_t(limit_obj);
+        if (limit == -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+        if (limit < 0) {
+            PyErr_SetString(PyExc_ValueError, "limit must be non-negative");
+            return NULL;
+        }
+    }
+
+    PyObject *result = PyList_New(0);
+    if (result == NULL || limit == 0) {
+        return result;
+    }
+
+    // Only descend into subtrees that contain an error.
+    TSTreeCursor cursor = ts_tree_cursor_new(ts_tree_root_node(self->tree));
+    for (;;) {
+        TSNode node = ts_tree_cursor_current_node(&cursor);
+        if (ts_node_is_error(node) || ts_node_is_missing(node)) {
+            PyObject *item = node_new_internal(state, node, (PyObject *)self);
+            if (item == NULL || PyList_Append(result, item) < 0) {
+                Py_XDECREF(item);
+                Py_CLEAR(result);
+                break;
+            }
+            Py_DECREF(item);
+            if (PyList_GET_SIZE(result) == limit) {
+                break;
+            }
+        } else if (ts_node_has_error(node) && ts_tree_cursor_goto_first_child(&cursor)) {
+            continue;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                goto done;
+            }
+        }
+    }
+
+done:
+    ts_tree_cursor_delete(&cursor);
+    return result;
+}
+
+// The caller releases the GIL, so the tree must be a copy that no other thread edits.
+// ERROR nodes have a kind id past the end of the symbol table and get the last bucket.
+static bool tree_stats_collect(const TSTree *tree, TreeStats *stats) {
+    stats->kind_count = ts_language_symbol_count(ts_tree_language(tree)) + 1;
+    stats->kinds = PyMem_RawCalloc(stats->kind_count, sizeof(uint32_t));
+    if (stats->kinds == NULL) {
+        return false;
+    }
+
+    bool ok = true;
+    uint32_t depth = 0, error_depth = UINT32_MAX;
+    TSTreeCursor cursor = ts_tree_cursor_new(ts_tree_root_node(tree));
+    for (;;) {
+        TSNode node = ts_tree_cursor_current_node(&cursor);
+        TSSymbol symbol = ts_node_symbol(node);
+        stats->kinds[symbol < stats->kind_count - 1 ? symbol : stats->kind_count - 1] += 1;
+
+        if (depth >= stats->depth_capacity) {
+            uint32_t capacity = stats->depth_capacity ? stats->depth_capacity * 2 : 64;
+            uint32_t *depths = PyMem_RawRealloc(stats->depths, capacity * sizeof(uint32_t));
+            if (depths == NULL) {
+                ok = false;
+                break;
+            }
+            memset(depths + stats->depth_capacity, 0,
+                   (capacity - stats->depth_capacity) * sizeof(uint32_t));
+            stats->depths = depths;
+            stats->depth_capacity = capacity;
+        }
+        stats->depths[depth] += 1;
+        if (depth >= stats->depth_count) {
+            stats->depth_count = depth + 1;
+        }
+
+        if (ts_node_is_named(node)) {
+            stats->named += 1;
+        } else {
+            stats->anonymous += 1;
+        }
+        if (ts_node_is_extra(node)) {
+            stats->extra += 1;
+        }
+        if (ts_node_is_missing(node)) {
+            stats->missing += 1;
+        }
+        if (ts_node_is_error(node)) {
+            stats->errors += 1;
+            if (error_depth == UINT32_MAX) {
+                error_depth = depth;
+                stats->error_bytes += ts_node_end_byte(node) - ts_node_start_byte(node);
+            }
+        }
+
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            depth += 1;
+            continue;
+        }
+        stats->covered_bytes += ts_node_end_byte(node) - ts_node_start_byte(node);
+        if (error_depth == depth) {
+            error_depth = UINT32_MAX;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                goto done;
+            }
+            depth -= 1;
+            if (error_depth == depth) {
+                error_depth = UINT32_MAX;
+            }
+        }
+    }
+
+done:
+    ts_tree_cursor_delete(&cursor);
+    return ok;
+}
+
+PyObject *tree_stats(Tree *self, PyObject *Py_UNUSED(args)) {
+    ModuleState *state = GET_MODULE_STATE(self);
+    TreeStats stats = {0};
+    TSTree *tree = ts_tree_copy(self->tree);
+    bool ok;
+    Py_BEGIN_ALLOW_THREADS
+    ok = tree_stats_collect(tree, &stats);
+    Py_END_ALLOW_THREADS
+    ts_tree_delete(tree);
+    if (!ok) {
+        PyMem_RawFree(stats.kinds);
+        PyMem_RawFree(stats.depths);
+        return PyErr_NoMemory();
+    }
+
+    PyObject *kinds =
+        packed_array_new(state, "I", stats.kinds, stats.kind_count * sizeof(uint32_t));
+    PyObject *depths =
+        packed_array_new(state, "I", stats.depths, stats.depth_count * sizeof(uint32_t));
+    PyMem_RawFree(stats.kinds);
+    PyMem_RawFree(stats.depths);
+    if (kinds == NULL || depths == NULL) {
+        Py_XDECREF(kinds);
+        Py_XDECREF(depths);
+        return NULL;
+    }
+    return Py_BuildValue("{s:N,s:N,s:K,s:K,s:K,s:K,s:K,s:K,s:K}", "kinds", kinds, "depths", depths,
+                         "named", stats.named, "anonymous", stats.anonymous, "extra", stats.extra,
+                         "errors", stats.errors, "missing", stats.missing, "covered_bytes",
+                         stats.covered_bytes, "error_bytes", stats.error_bytes);
+}
+
+#define TOKEN_FIELDS 5
+
+PyObject *tree_tokens(Tree *self, PyObject *args, PyObject *kwargs) {
+    ModuleState *state = GET_MODULE_STATE(self);
+    int include_extras = 1, include_text = 0;
+    char *keywords[] = {"include_extras", "include_text", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|p$p:tokens", keywords, &include_extras,
+                                     &include_text)) {
+        return NULL;
+    }
+
+    // Another export keeps the source alive while the arrays are created.
+    Py_buffer source_view = {.obj = NULL};
+    if (include_text) {
+        const Py_buffer *view = tree_get_source_view(self);
+        if (view == NULL) {
+            if (!PyErr_Occurred()) {
+                PyErr_SetString(PyExc_ValueError,
+                                "include_text requires the source of the tree to be available");
+            }
+            return NULL;
+        }
+        if (PyObject_GetBuffer(view->obj, &source_view, PyBUF_SIMPLE) < 0) {
+            return NULL;
+        }
+    }
+
+    PyObject *result = NULL;
+    uint32_t *tokens = NULL;
+    size_t token_count = 0, capacity = 0, text_length = 0;
+    TSTreeCursor cursor = ts_tree_cursor_new(ts_tree_root_node(self->tree));
+    for (;;) {
+        TSNode node = ts_tree_cursor_current_node(&cursor);
+        bool is_extra = ts_node_is_extra(node);
+        if (is_extra && !include_extras) {
+            goto next;
+        }
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            continue;
+        }
+
+        if (token_count == capacity) {
+            capacity = capacity ? capacity * 2 : 256;
+            uint32_t *resized = PyMem_Realloc(tokens, capacity * TOKEN_FIELDS * sizeof(uint32_t));
+            if (resized == NULL) {
+                PyErr_NoMemory();
+                goto cleanup;
+            }
+            tokens = resized;
+        }
+        uint32_t *token = tokens + token_count++ * TOKEN_FIELDS;
+        token[0] = ts_node_symbol(node);
+        token[1] = ts_node_start_byte(node);
+        token[2] = ts_node_end_byte(node);
+        token[3] = ts_node_is_named(node);
+        token[4] = is_extra;
+        if (include_text) {
+            size_t end_byte = Py_MIN((size_t)token[2], (size_t)source_view.len);
+            text_length += token[1] < end_byte ? end_byte - token[1] : 0;
+        }
+
+    next:
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                goto done;
+            }
+        }
+    }
+
+done:
+    result = packed_array_new(state, "I", tokens, token_count * TOKEN_FIELDS * sizeof(uint32_t));
+    if (result == NULL || !include_text) {
+        goto cleanup;
+    }
+
+    PyObject *text = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)text_length);
+    uint32_t *offsets = PyMem_Calloc(token_count + 1, sizeof(uint32_t));
+    if (text == NULL || offsets == NULL) {
+        Py_XDECREF(text);
+        Py_CLEAR(result);
+        if (offsets == NULL) {
+            PyErr_NoMemory();
+        }
+        PyMem_Free(offsets);
+        goto cleanup;
+    }
+    const char *source = source_view.buf;
+    char *buffer = PyBytes_AS_STRING(text);
+    uint32_t offset = 0;
+    for (size_t i = 0; i < token_count; ++i) {
+        uint32_t start_byte = tokens[i * TOKEN_FIELDS + 1];
+        size_t end_byte = Py_MIN((size_t)tokens[i * TOKEN_FIELDS + 2], (size_t)source_view.len);
+        uint32_t length = start_byte < end_byte ? (uint32_t)(end_byte - start_byte) : 0;
+        memcpy(buffer + offset, source + start_byte, length);
+        offsets[i] = offset;
+        offset += length;
+    }
+    offsets[token_count] = offset;
+
+    PyObject *offsets_array =
+        packed_array_new(state, "I", offsets, (token_count + 1) * sizeof(uint32_t));
+    PyMem_Free(offsets);
+    if (offsets_array == NULL) {
+        Py_XDECREF(text);
+        Py_XDECREF(offsets_array);
+        Py_CLEAR(result);
+        goto cleanup;
+    }
+    Py_SETREF(result, PyTuple_Pack(3, result, text, offsets_array));
+    Py_DECREF(text);
+    Py_DECREF(offsets_array);
+
+cleanup:
+    ts_tree_cursor_delete(&cursor);
+    PyMem_Free(tokens);
+    if (source_view.obj != NULL) {
+        PyBuffer_Release(&source_view);
+    }
+    return result;
+}
+
+static bool chunker_emit(TreeChunker *self, uint32_t start_byte, uint32_t end_byte) {
+    if (self->size + 2 > self->capacity) {
+        size_t capacity = self->capacity ? self->capacity * 2 : 64;
+        uint32_t *ranges = PyMem_RawRealloc(self->ranges, capacity * sizeof(uint32_t));
+        if (ranges == NULL) {
+            return false;
+        }
+        self->ranges = ranges;
+        self->capacity = capacity;
+    }
+    if (self->size > 0 && self->overlap > 0) {
+        uint32_t previous_start = self->ranges[self->size - 2];
+        uint32_t previous_end = self->ranges[self->size - 1];
+        uint32_t overlap_start =
+            previous_end - previous_start > self->overlap ? previous_end - self->overlap
+                                                          : previous_start;
+        while (self->text != NULL && overlap_start < previous_end &&
+               overlap_start < self->text_length && (self->text[overlap_start] & 0xC0) == 0x80) {
+            overlap_start += 1;
+        }
+        if (overlap_start < start_byte) {
+            start_byte = overlap_start;
+        }
+    }
+    self->ranges[self->size++] = start_byte;
+    self->ranges[self->size++] = end_byte;
+    return true;
+}
+
+static bool chunker_flush(TreeChunker *self) {
+    if (!self->pending) {
+        return true;
+    }
+    self->pending = false;
+    return chunker_emit(self, self->start_byte, self->end_byte);
+}
+
+// Move a split point inside a leaf back to the start of a UTF-8 sequence. If the sequence
+// starts before the piece does, move the split point past the sequence instead.
+static uint32_t chunker_split_point(const TreeChunker *self, uint32_t start_byte,
+                                    uint32_t split_byte, uint32_t end_byte) {
+    if (self->text == NULL || split_byte >= end_byte || split_byte >= self->text_length) {
+        return split_byte;
+    }
+    uint32_t byte = split_byte;
+    while (byte > start_byte && (self->text[byte] & 0xC0) == 0x80) {
+        byte -= 1;
+    }
+    if (byte > start_byte) {
+        return byte;
+    }
+    while (split_byte < end_byte && split_byte < self->text_length &&
+           (self->text[split_byte] & 0xC0) == 0x80) {
+        split_byte += 1;
+    }
+    return split_byte;
+}
+
+// Greedily pack siblings into chunks and only descend into nodes that do not fit.
+static bool chunker_collect(TreeChunker *self, const TSTree *tree) {
+    bool ok = true;
+    uint32_t depth = 0;
+    TSTreeCursor cursor = ts_tree_cursor_new(ts_tree_root_node(tree));
+    for (;;) {
+        TSNode node = ts_tree_cursor_current_node(&cursor);
+        uint32_t start_byte = ts_node_start_byte(node), end_byte = ts_node_end_byte(node);
+        TSSymbol symbol = ts_node_symbol(node);
+        if (end_byte - start_byte > self->max_bytes) {
+            if (!(ok = chunker_flush(self))) {
+                break;
+            }
+            if (ts_tree_cursor_goto_first_child(&cursor)) {
+                depth += 1;
+                continue;
+            }
+            for (uint32_t byte = start_byte; ok && byte < end_byte;) {
+                uint32_t chunk_end = end_byte - byte > self->max_bytes ? byte + self->max_bytes
+                                                                       : end_byte;
+                chunk_end = chunker_split_point(self, byte, chunk_end, end_byte);
+                ok = chunker_emit(self, byte, chunk_end);
+                byte = chunk_end;
+            }
+        } else if (self->prefer_kinds != NULL && symbol < self->kind_count &&
+                   self->prefer_kinds[symbol]) {
+            ok = chunker_flush(self) && chunker_emit(self, start_byte, end_byte);
+        } else if (self->pending && end_byte - self->start_byte > self->max_bytes) {
+            ok = chunker_flush(self);
+            self->pending = true;
+            self->start_byte = start_byte;
+            self->end_byte = end_byte;
+        } else {
+            if (!self->pending) {
+                self->pending = true;
+                self->start_byte = start_byte;
+            }
+            self->end_byte = end_byte;
+        }
+
+        // Chunks never span across the boundary of a node that was split.
+        while (ok && (depth == 0 || !ts_tree_cursor_goto_next_sibling(&cursor))) {
+            if (depth == 0 || !ts_tree_cursor_goto_parent(&cursor)) {
+                goto done;
+            }
+            depth -= 1;
+            ok = chunker_flush(self);
+        }
+        if (!ok) {
+            break;
+        }
+    }
+
+done:
+    ts_tree_cursor_delete(&cursor);
+    return ok && chunker_flush(self);
+}
+
+PyObject *tree_chunk(Tree *self, PyObject *args, PyObject *kwargs) {
+    ModuleState *state = GET_MODULE_STATE(self);
+    uint32_t max_bytes, overlap = 0;
+    PyObject *prefer_kinds_obj = Py_None;
+    char *keywords[] = {"max_bytes", "prefer_kinds", "overlap", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "I|$OI:chunk", keywords, &max_bytes,
+                                     &prefer_kinds_obj, &overlap)) {
+        return NULL;
+    }
+    if (max_bytes == 0) {
+        PyErr_SetString(PyExc_ValueError, "max_bytes must be positive");
+        return NULL;
+    }
+
+    TreeChunker chunker = {
+        .max_bytes = max_bytes,
+        .overlap = overlap,
+        .kind_count = ts_language_symbol_count(ts_tree_language(self->tree)),
+    };
+    bool *prefer_kinds = NULL;
+    if (prefer_kinds_obj != Py_None) {
+        prefer_kinds = language_kind_set_new((Language *)self->language, prefer_kinds_obj);
+        if (prefer_kinds == NULL) {
+            return NULL;
+        }
+        chunker.prefer_kinds = prefer_kinds;
+    }
+
+    // The text is only needed to split leaves, so chunking works without it, too.
+    // Another export keeps it alive if the tree is edited while the GIL is released.
+    Py_buffer text = {.obj = NULL};
+    const Py_buffer *view = tree_get_source_view(self);
+    if ((view == NULL && PyErr_Occurred()) ||
+        (view != NULL && PyObject_GetBuffer(view->obj, &text, PyBUF_SIMPLE) < 0)) {
+        PyMem_RawFree(prefer_kinds);
+        return NULL;
+    }
+    chunker.text = text.buf;
+    chunker.text_length = (uint32_t)text.len;
+
+    TSTree *tree = ts_tree_copy(self->tree);
+    bool ok;
+    Py_BEGIN_ALLOW_THREADS
+    ok = chunker_collect(&chunker, tree);
+    Py_END_ALLOW_THREADS
+    ts_tree_delete(tree);
+    if (text.obj != NULL) {
+        PyBuffer_Release(&text);
+    }
+    PyMem_RawFree(prefer_kinds);
+    PyObject *result = ok ? packed_array_new(state, "I", chunker.ranges,
+                                             chunker.size * sizeof(uint32_t))
+                          : PyErr_NoMemory();
+    PyMem_RawFree(chunker.ranges);
+    return result;
+}
+
+PyObject *tree_get_tracker(Tree *self, void *Py_UNUSED(payload)) {
+    if (self->tracker == NULL || self->tracker->tree != self) {
+        Py_RETURN_NONE;
+    }
+    return Py_NewRef(self->tracker);
+}
+
+// Copying the text of large batches is worth releasing the GIL for.
+#define TEXTS_NOGIL_THRESHOLD (1u << 20)
+
+static bool texts_item_range(Tree *self, PyObject *item, uint32_t *range) {
+    ModuleState *state = GET_MODULE_STATE(self);
+    if (PyObject_TypeCheck(item, state->node_type)) {
+        if (((Node *)item)->tree != (PyObject *)self) {
+            PyErr_SetString(PyExc_ValueError, "texts() nodes must belong to this tree");
+            return false;
+        }
+        range[0] = ts_node_start_byte(((Node *)item)->node);
+        range[1] = ts_node_end_byte(((Node *)item)->node);
+        return true;
+    }
+    if (PyObject_TypeCheck(item, state->range_type)) {
+        range[0] = ((Range *)item)->range.start_byte;
+        range[1] = ((Range *)item)->range.end_byte;
+        return true;
+    }
+    if (!PyArg_Parse(item, "(II)", &range[0], &range[1])) {
+        PyErr_Format(PyExc_TypeError,
+                     "texts() items must be nodes, ranges or pairs of byte offsets, not %s",
+                     Py_TYPE(item)->tp_name);
+        return false;
+    }
+    if (range[0] > range[1]) {
+        PyErr_Format(PyExc_ValueError, "Invalid byte range: %u to %u", range[0], range[1]);
+        return false;
+    }
+    return true;
+}
+
+static void texts_copy(char *buffer, uint32_t *offsets, const uint32_t *ranges, size_t count,
+                       const char *source) {
+    uint32_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t length = ranges[i * 2 + 1] - ranges[i * 2];
+        memcpy(buffer + offset, source + ranges[i * 2], length);
+        offsets[i] = offset;
+        offset += length;
+    }
+    offsets[count] = offset;
+}
+
+PyObject *tree_texts(Tree *self, PyObject *args, PyObject *kwargs) {
+    ModuleState *state = GET_MODULE_STATE(self);
+    PyObject *items;
+    int as_str = 0, packed = 0;
+    char *keywords[] = {"", "as_str", "packed", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|$pp:texts", keywords, &items, &as_str,
+                                     &packed)) {
+        return NULL;
+    }
+    if (as_str && packed) {
+        PyErr_SetString(PyExc_ValueError, "as_str and packed cannot be combined");
+        return NULL;
+    }
+
+    const Py_buffer *view = tree_get_source_view(self);
+    if (view == NULL) {
+        if (!PyErr_Occurred()) {
+            PyErr_SetString(PyExc_ValueError, "The tree has no source that can be read");
+        }
+        return NULL;
+    }
+    // The cached view is released if the tree is edited, which can happen while
+    // the items are read or while the GIL is released, so hold another export.
+    Py_buffer source_view;
+    if (PyObject_GetBuffer(view->obj, &source_view, PyBUF_SIMPLE) < 0) {
+        return NULL;
+    }
+    const char *source = source_view.buf;
+    uint32_t source_length = (uint32_t)source_view.len;
+
+    PyObject *result = NULL, *sequence = NULL;
+    uint32_t *ranges = NULL, *offsets = NULL;
+    sequence = PySequence_Fast(items, "texts() argument must be iterable");
+    if (sequence == NULL) {
+        goto cleanup;
+    }
+    size_t count = (size_t)PySequence_Fast_GET_SIZE(sequence);
+    ranges = PyMem_RawMalloc(Py_MAX(count, 1) * 2 * sizeof(uint32_t));
+    if (ranges == NULL) {
+        PyErr_NoMemory();
+        goto cleanup;
+    }
+    size_t text_length = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t *range = ranges + i * 2;
+        if (!texts_item_range(self, PySequence_Fast_GET_ITEM(sequence, i), range)) {
+            goto cleanup;
+        }
+        range[1] = Py_MIN(range[1], source_length);
+        range[0] = Py_MIN(range[0], range[1]);
+        text_length += range[1] - range[0];
+    }
+
+    if (!packed) {
+        result = PyList_New((Py_ssize_t)count);
+        for (size_t i = 0; result != NULL && i < count; ++i) {
+            const char *text = source + ranges[i * 2];
+            Py_ssize_t length = ranges[i * 2 + 1] - ranges[i * 2];
+            PyObject *item = as_str ? PyUnicode_DecodeUTF8(text, length, NULL)
+                                    : PyBytes_FromStringAndSize(text, length);
+            if (item == NULL) {
+                Py_CLEAR(result);
+                break;
+            }
+            PyList_SET_ITEM(result, i, item);
+        }
+        goto cleanup;
+    }
+
+    if (text_length > UINT32_MAX) {
+        PyErr_SetString(PyExc_OverflowError, "The combined text is too large");
+        goto cleanup;
+    }
+    PyObject *text = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)text_length);
+    offsets = PyMem_RawMalloc((count + 1) * sizeof(uint32_t));
+    if (text == NULL || offsets == NULL) {
+        Py_XDECREF(text);
+        if (offsets == NULL) {
+            PyErr_NoMemory();
+        }
+        goto cleanup;
+    }
+    char *buffer = PyBytes_AS_STRING(text);
+    if (text_length >= TEXTS_NOGIL_THRESHOLD) {
+        Py_BEGIN_ALLOW_THREADS
+        texts_copy(buffer, offsets, ranges, count, source);
+        Py_END_ALLOW_THREADS
+    } else {
+        texts_copy(buffer, offsets, ranges, count, source);
+    }
+
+    PyObject *offsets_array = packed_array_new(state, "I", offsets, (count + 1) * sizeof(uint32_t));
+    if (offsets_array != NULL) {
+        result = PyTuple_Pack(2, text, offsets_array);
+    }
+    Py_DECREF(text);
+    Py_XDECREF(offsets_array);
+
+cleanup:
+    Py_XDECREF(sequence);
+    PyMem_RawFree(ranges);
+    PyMem_RawFree(offsets);
+    PyBuffer_Release(&source_view);
+    return result;
+}
+
+PyObject *tree_get_intern_nodes(Tree *self, void *Py_UNUSED(payload)) {
+    return PyBool_FromLong(self->nodes != NULL);
+}
+
+int tree_set_intern_nodes(Tree *self, PyObject *arg, void *Py_UNUSED(payload)) {
+    int intern_nodes = arg != NULL ? PyObject_IsTrue(arg) : 0;
+    if (intern_nodes < 0) {
+        return -1;
+    }
+    if (!intern_nodes) {
+        node_table_delete(self->nodes);
+        self->nodes = NULL;
+    } else if (self->nodes == NULL && (self->nodes = node_table_new()) == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    return 0;
+}
+
 PyObject *tree_get_language(Tree *self, PyObject *Py_UNUSED(args)) {
     return Py_NewRef(self->language);
 }
@@ -187,6 +1110,131 @@ PyDoc_STRVAR(
 PyDoc_STRVAR(tree_print_dot_graph_doc,
              "print_dot_graph(self, /, file)\n--\n\n"
              "Write a DOT graph describing the syntax tree to the given file.");
+PyDoc_STRVAR(tree_build_parent_index_doc,
+             "build_parent_index(self, /)\n--\n\n"
+             "Record the parent and siblings of every node in the tree.\n\n"
+             "Afterwards, :attr:`Node.parent`, :attr:`Node.next_sibling` and "
+             ":attr:`Node.prev_sibling` take constant time instead of searching down from the "
+             "root node." DOC_NOTE "The index is discarded when the tree is edited.");
+PyDoc_STRVAR(
+    tree_compute_hashes_doc,
+    "compute_hashes(self, /, include_text=True)\n--\n\n"
+    "Compute a structural hash for every node in the tree.\n\n"
+    "The hash of a node combines its kind, the hashes and field names of its children and, "
+    "if ``include_text`` is true, the text of the leaf nodes. Identical subtrees have the "
+    "same hash regardless of their position, both within a tree and across trees of the same "
+    "language." DOC_NOTE "The hashes are computed once and read with :attr:`Node.structural_hash`. "
+    "They are discarded when the tree is edited." DOC_RAISES
+    "ValueError\n\n   If ``include_text`` is true and the source of the tree is not available, "
+    "e.g. because the tree was edited.");
+PyDoc_STRVAR(tree_errors_doc,
+             "errors(self, /, limit=None)\n--\n\n"
+             "Get the ``ERROR`` and ``MISSING`` nodes of the tree in document order.\n\n"
+             "Only the subtrees that contain errors are visited, so the cost does not depend "
+             "on the size of the error-free parts of the tree." DOC_PARAMETERS
+             "limit\n\n   The maximum number of nodes to return." DOC_NOTE
+             "The nodes inside of an ``ERROR`` node are not reported separately.");
+PyDoc_STRVAR(
+    tree_stats_doc,
+    "stats(self, /)\n--\n\n"
+    "Collect statistics about the nodes of the tree in a single pass." DOC_RETURNS
+    "A dictionary with the following items:\n\n"
+    "* ``kinds``: an :class:`array.array` with the number of nodes of each kind, indexed by "
+    "kind id. The last item is the number of ``ERROR`` nodes.\n"
+    "* ``depths``: an :class:`array.array` with the number of nodes at each depth, "
+    "starting with the root node.\n"
+    "* ``named``, ``anonymous``, ``extra``: the number of nodes of each type.\n"
+    "* ``errors``, ``missing``: the number of ``ERROR`` and ``MISSING`` nodes.\n"
+    "* ``covered_bytes``: the number of bytes that are covered by leaf nodes.\n"
+    "* ``error_bytes``: the number of bytes that are covered by ``ERROR`` nodes." DOC_NOTE
+    "The GIL is released during the traversal, so the statistics of different trees "
+    "can be collected in parallel threads. The tree can be edited by another thread in the "
+    "meantime; the statistics describe the tree as it was when this method was called.");
+PyDoc_STRVAR(
+    tree_tokens_doc,
+    "tokens(self, /, include_extras=True, *, include_text=False)\n--\n\n"
+    "Get the leaf tokens of the tree in document order, collected in a single walk." DOC_PARAMETERS
+    "include_extras\n\n   Whether to include extra tokens, such as comments.\n"
+    "include_text\n\n   Whether to also return the text of the tokens." DOC_RETURNS
+    "An :class:`array.array` with five items per token: the kind id, the start byte, "
+    "the end byte, whether the token is named and whether it is extra.\n\n"
+    "If ``include_text`` is true, a tuple of this array, a :class:`bytes` object with "
+    "the concatenated text of the tokens and an :class:`array.array` of offsets into it. "
+    "The text of the ``i``-th token is ``text[offsets[i]:offsets[i + 1]]``." DOC_RAISES
+    "ValueError\n\n   If ``include_text`` is true and the source of the tree is not available, "
+    "e.g. because the tree was edited.");
+PyDoc_STRVAR(
+    tree_path_contexts_doc,
+    "path_contexts(self, /, max_length=8, max_width=2, *, leaf_filter=None, hashed=True)\n--\n\n"
+    "Extract the path contexts between pairs of leaf nodes, as used by code2vec.\n\n"
+    "A path goes up from a leaf to the lowest common ancestor of the two leaves and then "
+    "down to the other leaf, and consists of the kind ids of the nodes along the way, "
+    "including both leaves." DOC_PARAMETERS
+    "max_length\n\n   The maximum number of edges in a path.\n"
+    "max_width\n\n   The maximum distance between the children of the common ancestor "
+    "that contain the two leaves.\n"
+    "leaf_filter\n\n   An iterable of the kind ids or kind names of the leaves to consider. "
+    "By default, all leaves are considered.\n"
+    "hashed\n\n   Whether to return hashes of the paths instead of the kind ids." DOC_RETURNS
+    "If ``hashed`` is true, an :class:`array.array` with three items per path context: the "
+    "descendant index of the first leaf, the hash of the path and the descendant index of "
+    "the second leaf.\n\n"
+    "Otherwise, a tuple of an :class:`array.array` with five items per path context and an "
+    ":class:`array.array` of kind ids. The items are the descendant indices of the two leaves, "
+    "the offset and length of the path in the kind ids and the position of the common ancestor "
+    "in the path." DOC_NOTE "The GIL is released during the extraction, so a batch of trees can be "
+    "processed in parallel by calling this method from several threads, e.g. with a "
+    ":class:`concurrent.futures.ThreadPoolExecutor`." DOC_TIP
+    "The descendant indices can be passed to :meth:`TreeCursor.goto_descendant`.");
+PyDoc_STRVAR(
+    tree_chunk_doc,
+    "chunk(self, /, max_bytes, *, prefer_kinds=None, overlap=0)\n--\n\n"
+    "Split the source code of the tree into chunks that follow its syntactic structure.\n\n"
+    "Consecutive sibling nodes are packed into a chunk for as long as it fits into ``max_bytes``. "
+    "Nodes that are larger than that are split recursively, and leaf nodes that are still too "
+    "large are split between UTF-8 characters, or at any byte if the source of the tree is not "
+    "available." DOC_PARAMETERS
+    "max_bytes\n\n   The maximum size of a chunk, not counting the overlap.\n"
+    "prefer_kinds\n\n   An iterable of kind ids or kind names of nodes that should be kept "
+    "in chunks of their own, such as functions or classes.\n"
+    "overlap\n\n   The number of bytes at the end of each chunk to repeat at the start "
+    "of the next one." DOC_RETURNS
+    "An :class:`array.array` with the start and end byte of each chunk.");
+PyDoc_STRVAR(
+    tree_texts_doc,
+    "texts(self, items, /, *, as_str=False, packed=False)\n--\n\n"
+    "Get the text of many nodes or byte ranges of the tree at once." DOC_PARAMETERS
+    "items\n\n   A sequence of :class:`Node` and :class:`Range` objects, or of "
+    "``(start_byte, end_byte)`` pairs.\n"
+    "as_str\n\n   Whether to decode the texts from UTF-8.\n"
+    "packed\n\n   Whether to return the texts in a single :class:`bytes` object." DOC_RETURNS
+    "A list with the text of each item.\n\n"
+    "If ``packed`` is true, a tuple of a :class:`bytes` object with the concatenated texts "
+    "and an :class:`array.array` of offsets into it. The text of the ``i``-th item is "
+    "``text[offsets[i]:offsets[i + 1]]``." DOC_RAISES
+    "ValueError\n\n   If the tree has no source, because it was edited or its read callback "
+    "is too large to cache, or if a node belongs to another tree.");
+PyDoc_STRVAR(tree_to_utf16_point_doc,
+             "to_utf16_point(self, position, /)\n--\n\n"
+             "Convert a byte offset or a point with a byte column to a point with a column "
+             "in UTF-16 code units, as used by the Language Server Protocol." DOC_NOTE
+             "Lines are indexed on first use, and the columns of lines that are pure ASCII "
+             "are returned as they are. Positions past the end of a line are clamped to it."
+             DOC_RAISES "ValueError\n\n   If the tree has no source that can be read.");
+PyDoc_STRVAR(tree_from_utf16_point_doc,
+             "from_utf16_point(self, point, /)\n--\n\n"
+             "Convert a point with a column in UTF-16 code units to a point with a byte column."
+             DOC_SEE_ALSO ":meth:`to_utf16_point`");
+PyDoc_STRVAR(tree_to_utf16_points_doc,
+             "to_utf16_points(self, points, /)\n--\n\n"
+             "Convert many points with byte columns at once." DOC_PARAMETERS
+             "points\n\n   A buffer of unsigned 32-bit integers with the row and column of each "
+             "point, such as an :class:`array.array` with the ``I`` type code." DOC_RETURNS
+             "An :class:`array.array` with the converted points in the same layout.");
+PyDoc_STRVAR(tree_from_utf16_points_doc,
+             "from_utf16_points(self, points, /)\n--\n\n"
+             "Convert many points with UTF-16 columns at once." DOC_SEE_ALSO
+             ":meth:`to_utf16_points`");
 PyDoc_STRVAR(tree_copy_doc, "copy(self, /)\n--\n\n"
                             "Create a shallow copy of the tree.");
 PyDoc_STRVAR(tree_copy2_doc, "__copy__(self, /)\n--\n\n"
@@ -223,6 +1271,78 @@ static PyMethodDef tree_methods[] = {
         .ml_flags = METH_O,
         .ml_doc = tree_print_dot_graph_doc,
     },
+    {
+        .ml_name = "build_parent_index",
+        .ml_meth = (PyCFunction)tree_build_parent_index,
+        .ml_flags = METH_NOARGS,
+        .ml_doc = tree_build_parent_index_doc,
+    },
+    {
+        .ml_name = "compute_hashes",
+        .ml_meth = (PyCFunction)tree_compute_hashes,
+        .ml_flags = METH_KEYWORDS | METH_VARARGS,
+        .ml_doc = tree_compute_hashes_doc,
+    },
+    {
+        .ml_name = "errors",
+        .ml_meth = (PyCFunction)tree_errors,
+        .ml_flags = METH_KEYWORDS | METH_VARARGS,
+        .ml_doc = tree_errors_doc,
+    },
+    {
+        .ml_name = "stats",
+        .ml_meth = (PyCFunction)tree_stats,
+        .ml_flags = METH_NOARGS,
+        .ml_doc = tree_stats_doc,
+    },
+    {
+        .ml_name = "tokens",
+        .ml_meth = (PyCFunction)tree_tokens,
+        .ml_flags = METH_KEYWORDS | METH_VARARGS,
+        .ml_doc = tree_tokens_doc,
+    },
+    {
+        .ml_name = "path_contexts",
+        .ml_meth = (PyCFunction)tree_path_contexts,
+        .ml_flags = METH_KEYWORDS | METH_VARARGS,
+        .ml_doc = tree_path_contexts_doc,
+    },
+    {
+        .ml_name = "chunk",
+        .ml_meth = (PyCFunction)tree_chunk,
+        .ml_flags = METH_KEYWORDS | METH_VARARGS,
+        .ml_doc = tree_chunk_doc,
+    },
+    {
+        .ml_name = "texts",
+        .ml_meth = (PyCFunction)tree_texts,
+        .ml_flags = METH_KEYWORDS | METH_VARARGS,
+        .ml_doc = tree_texts_doc,
+    },
+    {
+        .ml_name = "to_utf16_point",
+        .ml_meth = (PyCFunction)tree_to_utf16_point,
+        .ml_flags = METH_O,
+        .ml_doc = tree_to_utf16_point_doc,
+    },
+    {
+        .ml_name = "from_utf16_point",
+        .ml_meth = (PyCFunction)tree_from_utf16_point,
+        .ml_flags = METH_O,
+        .ml_doc = tree_from_utf16_point_doc,
+    },
+    {
+        .ml_name = "to_utf16_points",
+        .ml_meth = (PyCFunction)tree_to_utf16_points,
+        .ml_flags = METH_O,
+        .ml_doc = tree_to_utf16_points_doc,
+    },
+    {
+        .ml_name = "from_utf16_points",
+        .ml_meth = (PyCFunction)tree_from_utf16_points,
+        .ml_flags = METH_O,
+        .ml_doc = tree_from_utf16_points_doc,
+    },
     {
         .ml_name = "copy",
         .ml_meth = (PyCFunction)tree_copy,
@@ -243,6 +1363,14 @@ static PyGetSetDef tree_accessors[] = {
      PyDoc_STR("The included ranges that were used to parse the syntax tree."), NULL},
     {"language", (getter)tree_get_language, NULL,
      PyDoc_STR("The language that was used to parse the syntax tree."), NULL},
+    {"tracker", (getter)tree_get_tracker, NULL,
+     PyDoc_STR("The :class:`NodeTracker` that is tracking the nodes of the tree, if any."), NULL},
+    {"intern_nodes", (getter)tree_get_intern_nodes, (setter)tree_set_intern_nodes,
+     PyDoc_STR("Whether the same :class:`Node` object is returned for a node while it is alive."
+               "\n\n"
+               "Nodes created before this was enabled or before the tree was edited "
+               "are not reused."),
+     NULL},
     {NULL},
 };
 
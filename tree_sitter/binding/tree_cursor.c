@@ -1,6 +1,7 @@
 #include "types.h"
 
 PyObject *node_new_internal(ModuleState *state, TSNode node, PyObject *tree);
+PyObject *language_field_name(Language *self, TSFieldId field_id);
 
 void tree_cursor_dealloc(TreeCursor *self) {
     ts_tree_cursor_delete(&self->cursor);
@@ -30,11 +31,8 @@ PyObject *tree_cursor_get_field_id(TreeCursor *self, void *Py_UNUSED(payload)) {
 }
 
 PyObject *tree_cursor_get_field_name(TreeCursor *self, void *Py_UNUSED(payload)) {
-    const char *field_name = ts_tree_cursor_current_field_name(&self->cursor);
-    if (field_name == NULL) {
-        Py_RETURN_NONE;
-    }
-    return PyUnicode_FromString(field_name);
+    Language *language = (Language *)((Tree *)self->tree)->language;
+    return language_field_name(language, ts_tree_cursor_current_field_id(&self->cursor));
 }
 
 PyObject *tree_cursor_get_depth(TreeCursor *self, void *Py_UNUSED(args)) {
@@ -92,9 +90,9 @@ PyObject *tree_cursor_goto_previous_sibling(TreeCursor *self, PyObject *Py_UNUSE
     return PyBool_FromLong(result);
 }
 
-PyObject *tree_cursor_goto_descendant(TreeCursor *self, PyObject *args) {
+PyObject *tree_cursor_goto_descendant(TreeCursor *self, PyObject *arg) {
     uint32_t index;
-    if (!PyArg_ParseTuple(args, "I:goto_descendant", &index)) {
+    if (!arg_as_uint32(arg, &index)) {
         return NULL;
     }
     ts_tree_cursor_goto_descendant(&self->cursor, index);
@@ -103,9 +101,9 @@ PyObject *tree_cursor_goto_descendant(TreeCursor *self, PyObject *args) {
     Py_RETURN_NONE;
 }
 
-PyObject *tree_cursor_goto_first_child_for_byte(TreeCursor *self, PyObject *args) {
+PyObject *tree_cursor_goto_first_child_for_byte(TreeCursor *self, PyObject *arg) {
     uint32_t byte;
-    if (!PyArg_ParseTuple(args, "I:goto_first_child_for_byte", &byte)) {
+    if (!arg_as_uint32(arg, &byte)) {
         return NULL;
     }
 
@@ -118,9 +116,9 @@ PyObject *tree_cursor_goto_first_child_for_byte(TreeCursor *self, PyObject *args
     return PyLong_FromUnsignedLong((uint32_t)result);
 }
 
-PyObject *tree_cursor_goto_first_child_for_point(TreeCursor *self, PyObject *args) {
+PyObject *tree_cursor_goto_first_child_for_point(TreeCursor *self, PyObject *arg) {
     TSPoint point;
-    if (!PyArg_ParseTuple(args, "(II):goto_first_child_for_point", &point.row, &point.column)) {
+    if (!arg_as_point(arg, &point)) {
         return NULL;
     }
 
@@ -133,10 +131,11 @@ PyObject *tree_cursor_goto_first_child_for_point(TreeCursor *self, PyObject *arg
     return PyLong_FromUnsignedLong((uint32_t)result);
 }
 
-PyObject *tree_cursor_reset(TreeCursor *self, PyObject *args) {
+PyObject *tree_cursor_reset(TreeCursor *self, PyObject *node_obj) {
     ModuleState *state = GET_MODULE_STATE(self);
-    PyObject *node_obj;
-    if (!PyArg_ParseTuple(args, "O!:reset", state->node_type, &node_obj)) {
+    if (!PyObject_TypeCheck(node_obj, state->node_type)) {
+        PyErr_Format(PyExc_TypeError, "reset() argument must be %s, not %s",
+                     state->node_type->tp_name, Py_TYPE(node_obj)->tp_name);
         return NULL;
     }
 
@@ -147,10 +146,11 @@ PyObject *tree_cursor_reset(TreeCursor *self, PyObject *args) {
     Py_RETURN_NONE;
 }
 
-PyObject *tree_cursor_reset_to(TreeCursor *self, PyObject *args) {
+PyObject *tree_cursor_reset_to(TreeCursor *self, PyObject *cursor_obj) {
     ModuleState *state = GET_MODULE_STATE(self);
-    PyObject *cursor_obj;
-    if (!PyArg_ParseTuple(args, "O!:reset_to", state->tree_cursor_type, &cursor_obj)) {
+    if (!PyObject_TypeCheck(cursor_obj, state->tree_cursor_type)) {
+        PyErr_Format(PyExc_TypeError, "reset_to() argument must be %s, not %s",
+                     state->tree_cursor_type->tp_name, Py_TYPE(cursor_obj)->tp_name);
         return NULL;
     }
 
@@ -262,31 +262,31 @@ static PyMethodDef tree_cursor_methods[] = {
     {
         .ml_name = "goto_descendant",
         .ml_meth = (PyCFunction)tree_cursor_goto_descendant,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = tree_cursor_goto_descendant_doc,
     },
     {
         .ml_name = "goto_first_child_for_byte",
         .ml_meth = (PyCFunction)tree_cursor_goto_first_child_for_byte,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = tree_cursor_goto_first_child_for_byte_doc,
     },
     {
         .ml_name = "goto_first_child_for_point",
         .ml_meth = (PyCFunction)tree_cursor_goto_first_child_for_point,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = tree_cursor_goto_first_child_for_point_doc,
     },
     {
         .ml_name = "reset",
         .ml_meth = (PyCFunction)tree_cursor_reset,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = tree_cursor_reset_doc,
     },
     {
         .ml_name = "reset_to",
         .ml_meth = (PyCFunction)tree_cursor_reset_to,
-        .ml_flags = METH_VARARGS,
+        .ml_flags = METH_O,
         .ml_doc = tree_cursor_reset_to_doc,
     },
     {
@@ -0,0 +1,211 @@
+#include "types.h"
+
+#include <string.h>
+
+#define INDEX_NONE UINT32_MAX
+
+static inline uint32_t slot_hash(const void *id) {
+    uint64_t key = (uint64_t)(uintptr_t)id >> 3;
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+void tree_index_delete(TreeIndex *index) {
+    if (index == NULL) {
+        return;
+    }
+    PyMem_Free(index->nodes);
+    PyMem_Free(index->parents);
+    PyMem_Free(index->prev_siblings);
+    PyMem_Free(index->sizes);
+    PyMem_Free(index->fields);
+    PyMem_Free(index->slot_keys);
+    PyMem_Free(index->slot_values);
+    PyMem_Free(index->hashes);
+    PyMem_Free(index);
+}
+
+static TreeIndex *tree_index_new(const TSTree *tree) {
+    TSNode root = ts_tree_root_node(tree);
+    uint32_t count = ts_node_descendant_count(root);
+    uint32_t capacity = 16;
+    while (capacity < count * 2) {
+        capacity *= 2;
+    }
+
+    TreeIndex *index = PyMem_Calloc(1, sizeof(TreeIndex));
+    if (index == NULL) {
+        return NULL;
+    }
+    index->nodes = PyMem_Calloc(count, sizeof(TSNode));
+    index->parents = PyMem_Calloc(count, sizeof(uint32_t));
+    index->prev_siblings = PyMem_Malloc(count * sizeof(uint32_t));
+    index->sizes = PyMem_Calloc(count, sizeof(uint32_t));
+    index->fields = PyMem_Calloc(count, sizeof(TSFieldId));
+    index->slot_keys = PyMem_Calloc(capacity, sizeof(const void *));
+    index->slot_values = PyMem_Calloc(capacity, sizeof(uint32_t));
+    index->slot_mask = capacity - 1;
+    if (!index->nodes || !index->parents || !index->prev_siblings || !index->sizes ||
+        !index->fields || !index->slot_keys || !index->slot_values) {
+        tree_index_delete(index);
+        return NULL;
+    }
+
+    // The preorder position of a node matches its descendant index in a tree cursor.
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    uint32_t i = 0, parent = INDEX_NONE;
+    while (i < count) {
+        TSNode node = ts_tree_cursor_current_node(&cursor);
+        index->nodes[i] = node;
+        index->fields[i] = ts_tree_cursor_current_field_id(&cursor);
+        index->parents[i] = parent;
+        index->sizes[i] = 1;
+
+        uint32_t slot = slot_hash(node.id) & index->slot_mask;
+        while (index->slot_keys[slot] != NULL) {
+            slot = (slot + 1) & index->slot_mask;
+        }
+        index->slot_keys[slot] = node.id;
+        index->slot_values[slot] = i;
+
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            parent = i++;
+            continue;
+        }
+        i++;
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                goto done;
+            }
+            parent = index->parents[parent];
+        }
+    }
+
+done:
+    ts_tree_cursor_delete(&cursor);
+    index->count = i;
+    for (uint32_t j = index->count; j-- > 1;) {
+        index->sizes[index->parents[j]] += index->sizes[j];
+    }
+    // The next sibling of a node is the first node after its subtree that has the same parent.
+    for (uint32_t j = 0; j < index->count; ++j) {
+        index->prev_siblings[j] = INDEX_NONE;
+    }
+    for (uint32_t j = 1; j < index->count; ++j) {
+        uint32_t next = j + index->sizes[j];
+        if (next < index->count && index->parents[next] == index->parents[j]) {
+            index->prev_siblings[next] = j;
+        }
+    }
+    return index;
+}
+
+TreeIndex *tree_index_get(Tree *tree) {
+    if (tree->index == NULL) {
+        tree->index = tree_index_new(tree->tree);
+        if (tree->index == NULL) {
+            PyErr_NoMemory();
+        }
+    }
+    return tree->index;
+}
+
+void tree_index_clear(Tree *tree) {
+    tree_index_delete(tree->index);
+    tree->index = NULL;
+}
+
+// Nodes from Tree.root_node_with_offset or Node.edit share the id of an indexed node,
+// but not its position, so they are treated as missing from the index.
+uint32_t tree_index_find(const TreeIndex *index, TSNode node) {
+    uint32_t slot = slot_hash(node.id) & index->slot_mask;
+    while (index->slot_keys[slot] != NULL) {
+        if (index->slot_keys[slot] == node.id) {
+            uint32_t i = index->slot_values[slot];
+            TSNode indexed = index->nodes[i];
+            TSPoint start = ts_node_start_point(node), indexed_start = ts_node_start_point(indexed);
+            bool same_position = ts_node_start_byte(indexed) == ts_node_start_byte(node) &&
+                                 indexed_start.row == start.row &&
+                                 indexed_start.column == start.column;
+            return same_position ? i : INDEX_NONE;
+        }
+        slot = (slot + 1) & index->slot_mask;
+    }
+    return INDEX_NONE;
+}
+
+static inline TSNode index_node(const TreeIndex *index, uint32_t i) {
+    return i != INDEX_NONE ? index->nodes[i] : (TSNode){0};
+}
+
+// These return false if the node is not in the index, and a null node if it has no such relative.
+bool tree_index_parent(const TreeIndex *index, TSNode node, TSNode *result) {
+    uint32_t i = tree_index_find(index, node);
+    if (i == INDEX_NONE) {
+        return false;
+    }
+    *result = index_node(index, index->parents[i]);
+    return true;
+}
+
+bool tree_index_next_sibling(const TreeIndex *index, TSNode node, TSNode *result) {
+    uint32_t i = tree_index_find(index, node);
+    if (i == INDEX_NONE) {
+        return false;
+    }
+    uint32_t next = i + index->sizes[i];
+    bool is_sibling = i > 0 && next < index->count && index->parents[next] == index->parents[i];
+    *result = index_node(index, is_sibling ? next : INDEX_NONE);
+    return true;
+}
+
+bool tree_index_prev_sibling(const TreeIndex *index, TSNode node, TSNode *result) {
+    uint32_t i = tree_index_find(index, node);
+    if (i == INDEX_NONE) {
+        return false;
+    }
+    *result = index_node(index, index->prev_siblings[i]);
+    return true;
+}
+
+void tree_index_hash(const TreeIndex *index, const char *text, uint32_t length,
+                     uint64_t *hashes) {
+    // Children come after their parent in preorder, so a reverse walk
+    // visits every subtree after all of its descendants.
+    for (uint32_t i = index->count; i-- > 0;) {
+        TSNode node = index->nodes[i];
+        uint64_t hash = hash_combine(HASH_SEED, ts_node_symbol(node));
+        hash = hash_combine(hash, ts_node_is_missing(node));
+
+        uint32_t end = i + index->sizes[i];
+        for (uint32_t child = i + 1; child < end; child += index->sizes[child]) {
+            hash = hash_combine(hash, index->fields[child]);
+            hash = hash_combine(hash, hashes[child]);
+        }
+
+        if (text != NULL && end == i + 1) {
+            uint32_t start_byte = ts_node_start_byte(node);
+            uint32_t end_byte = ts_node_end_byte(node);
+            if (end_byte > length) {
+                end_byte = length;
+            }
+            if (start_byte < end_byte) {
+                hash = hash_combine(hash, hash_bytes(text + start_byte, end_byte - start_byte));
+            }
+        }
+        hashes[i] = hash_finish(hash);
+    }
+}
+
+bool tree_index_compute_hashes(TreeIndex *index, const char *text, uint32_t length) {
+    uint64_t *hashes = index->hashes;
+    if (hashes == NULL) {
+        hashes = PyMem_Calloc(index->count, sizeof(uint64_t));
+        if (hashes == NULL) {
+            return false;
+        }
+    }
+    tree_index_hash(index, text, length, hashes);
+    index->hashes = hashes;
+    index->hashes_include_text = text != NULL;
+    return true;
+}
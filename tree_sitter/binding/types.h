@@ -13,18 +13,124 @@ typedef struct {
     PyObject *tree;
 } Node;
 
+// A view of the children of a node that creates the child nodes on access.
+// Named views pick their items from the view of all children of the same node.
+typedef struct ChildrenView {
+    PyObject_HEAD
+    TSNode node;
+    PyObject *tree;
+    struct ChildrenView *all;
+    uint32_t length;
+    TSNode *children;
+    uint32_t *indices;
+    PyObject **items;
+} ChildrenView;
+
+typedef struct TreeArena TreeArena;
+
+typedef struct {
+    size_t limit;
+    size_t used;
+    size_t peak;
+} MemoryBudget;
+
+typedef struct {
+    TreeArena *arena;
+    MemoryBudget *budget;
+} AllocatorState;
+
+// A preorder listing of all the nodes of a tree, built on demand.
+typedef struct {
+    TSNode *nodes;
+    uint32_t *parents;
+    uint32_t *prev_siblings;
+    uint32_t *sizes;
+    TSFieldId *fields;
+    uint32_t count;
+    // maps node ids to their preorder index
+    const void **slot_keys;
+    uint32_t *slot_values;
+    uint32_t slot_mask;
+    uint64_t *hashes;
+    bool hashes_include_text;
+} TreeIndex;
+
+typedef struct NodeTracker NodeTracker;
+
+typedef struct {
+    uint32_t *offsets;
+    bool *is_ascii;
+    uint32_t count;
+    uint32_t length;
+} LineIndex;
+
+// Borrowed references to the live nodes of a tree, removed by the nodes when they are freed.
+typedef struct {
+    const void *id;
+    uint32_t start_byte;
+    Node *node;
+} NodeTableSlot;
+
+typedef struct {
+    NodeTableSlot *slots;
+    uint32_t mask;
+    uint32_t size;
+} NodeTable;
+
 typedef struct {
     PyObject_HEAD
     TSTree *tree;
     PyObject *source;
     PyObject *language;
+    Py_buffer source_view;
+    uint32_t *char_offsets;
+    LineIndex *lines;
+    TreeArena *arena;
+    TreeIndex *index;
+    NodeTracker *tracker;
+    NodeTable *nodes;
 } Tree;
 
+typedef struct {
+    const void *key;
+    uint64_t id;
+    uint32_t generation;
+    TSSymbol symbol;
+} TrackedNode;
+
+struct NodeTracker {
+    PyObject_HEAD
+    Tree *tree;
+    TrackedNode *nodes;
+    uint32_t capacity;
+    uint32_t size;
+    uint32_t used;
+    uint32_t generation;
+    uint64_t next_id;
+};
+
+typedef struct {
+    const char *name;
+    uint32_t length;
+    uint16_t id;
+    bool is_named;
+} NameSlot;
+
+typedef struct {
+    NameSlot *slots;
+    uint32_t mask;
+} NameTable;
+
 typedef struct {
     PyObject_HEAD
     TSLanguage *language;
     uint32_t abi_version;
     const char *name;
+    PyObject **kind_names;
+    PyObject **field_names;
+    PyObject **error_names;
+    NameTable kind_ids;
+    NameTable field_ids;
 } Language;
 
 typedef struct {
@@ -32,6 +138,7 @@ typedef struct {
     TSParser *parser;
     PyObject *language;
     PyObject *logger;
+    size_t peak_memory;
 } Parser;
 
 typedef struct {
@@ -85,6 +192,7 @@ typedef struct {
     PyObject *predicates;
     PyObject *settings;
     PyObject *assertions;
+    PyObject *capture_names;
 } Query;
 
 typedef struct {
@@ -104,13 +212,50 @@ typedef struct {
     PyObject *language;
 } LookaheadIterator;
 
+typedef struct {
+    uint64_t hash;
+    uint32_t start_byte;
+    uint32_t end_byte;
+    uint32_t first;
+    uint32_t parent;
+} CloneEntry;
+
+typedef struct {
+    CloneEntry *entries;
+    uint32_t count;
+    bool used;
+} CloneTree;
+
+typedef struct {
+    PyObject_HEAD
+    uint32_t min_size;
+    bool abstract_identifiers;
+    const TSLanguage *language;
+    CloneTree *trees;
+    uint32_t tree_count;
+    uint32_t tree_capacity;
+    uint64_t *hashes;
+    uint32_t *counts;
+    uint32_t capacity;
+    uint32_t size;
+} CloneIndex;
+
+#define NODE_FREELIST_SIZE 256
+
 typedef struct {
     TSTreeCursor default_cursor;
+    PyObject *node_freelist[NODE_FREELIST_SIZE];
+    uint32_t node_freelist_size;
     PyObject *re_compile;
+    PyObject *array_type;
     PyObject *query_error;
+    PyObject *memory_limit_exceeded;
+    PyTypeObject *children_view_type;
+    PyTypeObject *clone_index_type;
     PyTypeObject *language_type;
     PyTypeObject *log_type_type;
     PyTypeObject *lookahead_iterator_type;
+    PyTypeObject *node_tracker_type;
     PyTypeObject *node_type;
     PyTypeObject *parser_type;
     PyTypeObject *point_type;
@@ -138,6 +283,85 @@ typedef struct {
 
 #define REPLACE(old, new) DEPRECATE(old " is deprecated. Use " new " instead.")
 
+// Hashing
+
+#define HASH_SEED 0xcbf29ce484222325ULL
+#define HASH_PRIME 0x100000001b3ULL
+
+static inline uint64_t hash_combine(uint64_t hash, uint64_t value) {
+    hash ^= value + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+static inline uint64_t hash_finish(uint64_t hash) {
+    hash ^= hash >> 30;
+    hash *= 0xBF58476D1CE4E5B9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94D049BB133111EBULL;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+static inline uint64_t hash_bytes(const char *bytes, uint32_t length) {
+    uint64_t hash = HASH_SEED;
+    for (uint32_t i = 0; i < length; ++i) {
+        hash = (hash ^ (uint8_t)bytes[i]) * HASH_PRIME;
+    }
+    return hash;
+}
+
+// Argument parsing
+//
+// These follow the conversions of the matching PyArg_Parse format units,
+// but work on the argument arrays of METH_O and METH_FASTCALL methods.
+
+static inline bool check_arg_count(const char *name, Py_ssize_t nargs, Py_ssize_t expected) {
+    if (nargs != expected) {
+        PyErr_Format(PyExc_TypeError, "%s() takes exactly %zd arguments (%zd given)", name,
+                     expected, nargs);
+        return false;
+    }
+    return true;
+}
+
+// "l"
+static inline bool arg_as_long(PyObject *arg, long *value) {
+    *value = PyLong_AsLong(arg);
+    return *value != -1 || !PyErr_Occurred();
+}
+
+// "I"
+static inline bool arg_as_uint32(PyObject *arg, uint32_t *value) {
+    unsigned long result = PyLong_AsUnsignedLongMask(arg);
+    *value = (uint32_t)result;
+    return result != (unsigned long)-1 || !PyErr_Occurred();
+}
+
+// "H"
+static inline bool arg_as_uint16(PyObject *arg, uint16_t *value) {
+    unsigned long result = PyLong_AsUnsignedLongMask(arg);
+    *value = (uint16_t)result;
+    return result != (unsigned long)-1 || !PyErr_Occurred();
+}
+
+// "(II)"
+static inline bool arg_as_point(PyObject *arg, TSPoint *point) {
+    if (!PyTuple_Check(arg) || PyTuple_GET_SIZE(arg) != 2) {
+        return PyArg_Parse(arg, "(II)", &point->row, &point->column);
+    }
+    return arg_as_uint32(PyTuple_GET_ITEM(arg, 0), &point->row) &&
+           arg_as_uint32(PyTuple_GET_ITEM(arg, 1), &point->column);
+}
+
+// "s#"
+static inline const char *arg_as_utf8(PyObject *arg, Py_ssize_t *length) {
+    if (PyUnicode_Check(arg)) {
+        return PyUnicode_AsUTF8AndSize(arg, length);
+    }
+    const char *string;
+    return PyArg_Parse(arg, "s#", &string, length) ? string : NULL;
+}
+
 // Docstrings
 
 #define DOC_ATTENTION "\n\nAttention\n---------\n"